@@ -32,6 +32,7 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/stdiostream.h"
 #include "common/algorithm.h"
+#include "common/system.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -44,14 +45,56 @@
 #endif
 
 
+/**
+ * How long (in milliseconds) the result of a stat() is reused by exists().
+ * Engines tend to check the same files over and over again, which is slow
+ * on network mounts. The lifetime keeps changes made by other means (like
+ * removing savegames) from going unnoticed for long.
+ */
+enum {
+	kStatCacheLifetime = 1000
+};
+
+/** Current stat cache generation, never 0. */
+static uint32 s_statGeneration = 1;
+
+static uint32 getStatClock() {
+	// Without a backend there is no clock, markStatFresh() then leaves
+	// the node uncached.
+	return g_system ? g_system->getMillis() : 0;
+}
+
+void POSIXFilesystemNode::invalidateStatCache() {
+	if (++s_statGeneration == 0)
+		s_statGeneration = 1;
+}
+
+void POSIXFilesystemNode::markStatFresh() const {
+	_statTime = getStatClock();
+	_statGeneration = g_system ? s_statGeneration : 0;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
 	_isValid = (0 == stat(_path.c_str(), &st));
 	_isDirectory = _isValid ? S_ISDIR(st.st_mode) : false;
+	markStatFresh();
+}
+
+bool POSIXFilesystemNode::exists() const {
+	if (_statGeneration == s_statGeneration && getStatClock() - _statTime < kStatCacheLifetime)
+		return _isValid;
+
+	// Only refresh the existence, isDirectory() has always reported the
+	// type the node was created with.
+	struct stat st;
+	_isValid = (0 == stat(_path.c_str(), &st));
+	markStatFresh();
+	return _isValid;
 }
 
-POSIXFilesystemNode::POSIXFilesystemNode(const Common::String &p) {
+POSIXFilesystemNode::POSIXFilesystemNode(const Common::String &p) : _statTime(0), _statGeneration(0) {
 	assert(p.size() > 0);
 
 	// Expand "~/" to the value of the HOME env variable
@@ -184,14 +227,19 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 			entry.setFlags();
 		} else {
 			entry._isValid = (dp->d_type == DT_DIR) || (dp->d_type == DT_REG) || (dp->d_type == DT_LNK);
+			entry._statGeneration = 0;
 			if (dp->d_type == DT_LNK) {
 				struct stat st;
-				if (stat(entry._path.c_str(), &st) == 0)
+				if (stat(entry._path.c_str(), &st) == 0) {
 					entry._isDirectory = S_ISDIR(st.st_mode);
-				else
+					entry.markStatFresh();
+				} else {
+					// Dangling link, let exists() decide
 					entry._isDirectory = false;
+				}
 			} else {
 				entry._isDirectory = (dp->d_type == DT_DIR);
+				entry.markStatFresh();
 			}
 		}
 #endif
@@ -247,6 +295,8 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 }
 
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
+	// The file is (re)created, so cached stat() results may be stale
+	invalidateStatCache();
 	return StdioStream::makeFromPath(getPath(), true);
 }
 
@@ -39,7 +39,12 @@ protected:
 	Common::String _displayName;
 	Common::String _path;
 	bool _isDirectory;
-	bool _isValid;
+	mutable bool _isValid;	// refreshed by exists()
+
+	/** Time of the last stat() backing _isValid, see exists(). */
+	mutable uint32 _statTime;
+	/** Stat cache generation _statTime belongs to, 0 if never stat()ed. */
+	mutable uint32 _statGeneration;
 
 	virtual AbstractFSNode *makeNode(const Common::String &path) const {
 		return new POSIXFilesystemNode(path);
@@ -48,7 +53,7 @@ protected:
 	/**
 	 * Plain constructor, for internal use only (hence protected).
 	 */
-	POSIXFilesystemNode() : _isDirectory(false), _isValid(false) {}
+	POSIXFilesystemNode() : _isDirectory(false), _isValid(false), _statTime(0), _statGeneration(0) {}
 
 public:
 	/**
@@ -58,7 +63,7 @@ public:
 	 */
 	POSIXFilesystemNode(const Common::String &path);
 
-	virtual bool exists() const { return access(_path.c_str(), F_OK) == 0; }
+	virtual bool exists() const;
 	virtual Common::String getDisplayName() const { return _displayName; }
 	virtual Common::String getName() const { return _displayName; }
 	virtual Common::String getPath() const { return _path; }
@@ -73,11 +78,23 @@ public:
 	virtual Common::SeekableReadStream *createReadStream();
 	virtual Common::WriteStream *createWriteStream();
 
+	/**
+	 * Forget all cached stat() results, so that the next exists() call on
+	 * any node queries the filesystem again. Call this after creating or
+	 * removing files behind the back of the nodes.
+	 */
+	static void invalidateStatCache();
+
 private:
 	/**
 	 * Tests and sets the _isValid and _isDirectory flags, using the stat() function.
 	 */
 	virtual void setFlags();
+
+	/**
+	 * Marks the current _isValid flag as freshly obtained from the filesystem.
+	 */
+	void markStatFresh() const;
 };
 
 #endif
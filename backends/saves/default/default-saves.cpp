@@ -20,6 +20,12 @@
  *
  */
 
+#if defined(POSIX) || defined(PLAYSTATION3)
+// posix-fs.h includes unistd.h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_exit		//Needed for IRIX's unistd.h
+#endif
+
 #include "common/scummsys.h"
 
 #if !defined(DISABLE_DEFAULT_SAVEFILEMANAGER)
@@ -33,6 +39,10 @@
 #include "common/config-manager.h"
 #include "common/zlib.h"
 
+#if defined(POSIX) || defined(PLAYSTATION3)
+#include "backends/fs/posix/posix-fs.h"	// for removeSavefile()
+#endif
+
 #ifndef _WIN32_WCE
 #include <errno.h>	// for removeSavefile()
 #endif
@@ -139,6 +149,10 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 #endif
 		return false;
 	} else {
+#if defined(POSIX) || defined(PLAYSTATION3)
+		// The file nodes may still remember that the file exists
+		POSIXFilesystemNode::invalidateStatCache();
+#endif
 		return true;
 	}
 }
@@ -62,6 +62,36 @@ int Archive::listMatchingMembers(ArchiveMemberList &list, const String &pattern)
 
 
 
+static uint32 getLookupMillis() {
+	return g_system ? g_system->getMillis() : 0;
+}
+
+SearchSet::SearchSet() {
+	resetLookupStats();
+}
+
+void SearchSet::resetLookupStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+Archive *SearchSet::lookupArchive(const String &name) const {
+	_stats.lookups++;
+
+	const uint32 start = getLookupMillis();
+	Archive *found = 0;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for ( ; it != _list.end(); ++it) {
+		_stats.archiveQueries++;
+		if (it->_arc->hasFile(name)) {
+			found = it->_arc;
+			break;
+		}
+	}
+	_stats.lookupMillis += getLookupMillis() - start;
+
+	return found;
+}
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for ( ; it != _list.end(); ++it) {
@@ -210,21 +240,21 @@ bool SearchSet::hasFile(const String &name) const {
 	if (name.empty())
 		return false;
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return true;
-	}
-
-	return false;
+	return lookupArchive(name) != 0;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
+	_stats.patternLookups++;
+
+	const uint32 start = getLookupMillis();
 	int matches = 0;
 
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it)
+	for ( ; it != _list.end(); ++it) {
+		_stats.archiveQueries++;
 		matches += it->_arc->listMatchingMembers(list, pattern);
+	}
+	_stats.lookupMillis += getLookupMillis() - start;
 
 	return matches;
 }
@@ -243,11 +273,9 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	Archive *arc = lookupArchive(name);
+	if (arc)
+		return arc->getMember(name);
 
 	return ArchiveMemberPtr();
 }
@@ -256,14 +284,18 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return 0;
 
+	_stats.lookups++;
+
+	const uint32 start = getLookupMillis();
+	SeekableReadStream *stream = 0;
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for ( ; it != _list.end(); ++it) {
-		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
-		if (stream)
-			return stream;
+	for ( ; it != _list.end() && !stream; ++it) {
+		_stats.archiveQueries++;
+		stream = it->_arc->createReadStreamForMember(name);
 	}
+	_stats.lookupMillis += getLookupMillis() - start;
 
-	return 0;
+	return stream;
 }
 
 
@@ -126,8 +126,22 @@ public:
  * contained Archives, hence the simplistic policy of always looking for the first
  * match. SearchSet *DOES* guarantee that searches are performed in *DESCENDING*
  * priority order. In case of conflicting priorities, insertion order prevails.
+ *
+ * Lookups are not cached, since the contained archives may change at any
+ * time. getLookupStats() tells how many lookups were made and how long
+ * they took.
  */
 class SearchSet : public Archive {
+public:
+	/** Statistics about lookups, see getLookupStats(). */
+	struct LookupStats {
+		uint32 lookups;			///< Name lookups (hasFile, getMember, createReadStreamForMember).
+		uint32 patternLookups;	///< Calls to listMatchingMembers.
+		uint32 archiveQueries;	///< Calls made to the contained archives for lookups.
+		uint32 lookupMillis;	///< Time spent in lookups.
+	};
+
+private:
 	struct Node {
 		int		_priority;
 		String	_name;
@@ -140,6 +154,11 @@ class SearchSet : public Archive {
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	mutable LookupStats _stats;
+
+	// Find the first archive which has the named file.
+	Archive *lookupArchive(const String &name) const;
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
@@ -147,6 +166,7 @@ class SearchSet : public Archive {
 	void insert(const Node& node);
 
 public:
+	SearchSet();
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -241,6 +261,9 @@ public:
 	 * opening the first file encountered that matches the name.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	const LookupStats &getLookupStats() const { return _stats; }
+	void resetLookupStats();
 };
 
 
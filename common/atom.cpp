@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/atom.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+namespace {
+
+typedef HashMap<String, const void *, IgnoreCase_Hash, IgnoreCase_EqualTo> InternTable;
+
+enum {
+	// Warn once the table holds this many strings, see the Atom docs
+	kInternTableWarnSize = 1 << 16
+};
+
+// Neither is ever freed, so that atoms stay valid during shutdown. The
+// table is created on first use, the mutex by Atom::initLocking().
+InternTable *g_internTable = 0;
+OSystem::MutexRef g_internMutex = 0;
+
+/**
+ * Locks the intern table for the lifetime of the object, as soon as the
+ * mutex exists.
+ */
+class InternTableLock {
+public:
+	InternTableLock() : _mutex(g_internMutex) {
+		if (_mutex)
+			g_system->lockMutex(_mutex);
+	}
+
+	~InternTableLock() {
+		if (_mutex)
+			g_system->unlockMutex(_mutex);
+	}
+
+private:
+	OSystem::MutexRef _mutex;
+};
+
+} // End of anonymous namespace
+
+Atom::Atom(const String &str) : _entry(intern(str, true)) {
+}
+
+Atom::Atom(const char *str) : _entry(intern(String(str), true)) {
+}
+
+Atom Atom::find(const String &str) {
+	return Atom(intern(str, false));
+}
+
+void Atom::initLocking() {
+	assert(g_system);
+	if (!g_internMutex)
+		g_internMutex = g_system->createMutex();
+}
+
+uint Atom::getInternedCount() {
+	InternTableLock lock;
+	return g_internTable ? g_internTable->size() : 0;
+}
+
+const String &Atom::toString() const {
+	static const String emptyString;
+	return _entry ? _entry->str : emptyString;
+}
+
+const Atom::Entry *Atom::intern(const String &str, bool create) {
+	InternTableLock lock;
+
+	if (!g_internTable) {
+		if (!create)
+			return 0;
+		g_internTable = new InternTable();
+	}
+
+	InternTable::const_iterator i = g_internTable->find(str);
+	if (i != g_internTable->end())
+		return (const Entry *)i->_value;
+	if (!create)
+		return 0;
+
+	// Copy the characters instead of sharing the storage (and its
+	// reference count) with the caller's string.
+	Entry *entry = new Entry();
+	entry->str = String(str.c_str(), str.size());
+	entry->hash = hashit_lower(str);
+	(*g_internTable)[entry->str] = entry;
+
+	if (g_internTable->size() == kInternTableWarnSize)
+		warning("Atom: %d strings have been interned, they are never freed", kInternTableWarnSize);
+
+	return entry;
+}
+
+} // End of namespace Common
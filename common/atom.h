@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOM_H
+#define COMMON_ATOM_H
+
+#include "common/func.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * An Atom is a handle to a string stored in a global intern table.
+ *
+ * Strings are interned case-insensitively: Atom("Data/File.dat") and
+ * Atom("DATA/FILE.DAT") are the same atom, and toString() returns the
+ * spelling which was interned first. This matches the file name and config
+ * key lookups which the atoms are meant for.
+ *
+ * Comparing two atoms only compares two pointers, and the case-insensitive
+ * hash of the string is computed once when it is interned. This makes
+ * atoms cheap keys for HashMap, which hashes every key again whenever it
+ * grows. Converting a String into an atom costs about as much as one
+ * lookup in a case-insensitive StringMap, so it pays off for keys which
+ * are stored or looked up repeatedly.
+ *
+ * Interned strings are never freed, since any copy of an atom may still
+ * refer to them. The table therefore only suits names from a bounded set,
+ * like the files in the game directories or config keys, and must not be
+ * fed arbitrary strings such as user input or generated text. A warning is
+ * printed if it grows suspiciously large.
+ *
+ * The intern table is protected by a mutex, which OSystem::initBackend()
+ * creates through initLocking() before any other thread is started. Atoms
+ * created before that (e.g. while parsing the command line) or without a
+ * backend must only be used from the main thread.
+ */
+class Atom {
+public:
+	/** Construct a null atom, which differs from all interned strings. */
+	Atom() : _entry(0) {}
+
+	/** Intern the given string. */
+	explicit Atom(const String &str);
+	explicit Atom(const char *str);
+
+	/**
+	 * Return the atom of the given string if it has been interned
+	 * already, or a null atom otherwise. Since nothing is interned, this
+	 * is a cheap way to find out that a name is not in any atom keyed map.
+	 */
+	static Atom find(const String &str);
+
+	/** Return the number of strings interned so far. */
+	static uint getInternedCount();
+
+	/**
+	 * Create the mutex protecting the intern table. Must be called once,
+	 * on the main thread, while no other threads use atoms yet.
+	 */
+	static void initLocking();
+
+	bool isNull() const { return _entry == 0; }
+
+	/** Return the interned string, or an empty string for a null atom. */
+	const String &toString() const;
+	const char *c_str() const { return toString().c_str(); }
+
+	/** Return the precomputed case-insensitive hash, see hashit_lower(). */
+	uint hash() const { return _entry ? _entry->hash : 0; }
+
+	bool operator==(const Atom &x) const { return _entry == x._entry; }
+	bool operator!=(const Atom &x) const { return _entry != x._entry; }
+
+private:
+	struct Entry {
+		String str;
+		uint hash;
+	};
+
+	const Entry *_entry;
+
+	explicit Atom(const Entry *entry) : _entry(entry) {}
+
+	static const Entry *intern(const String &str, bool create);
+};
+
+// Specialization of the Hash functor for atoms, using the hash
+// stored in the intern table.
+template<>
+struct Hash<Atom> {
+	uint operator()(const Atom &x) const { return x.hash(); }
+};
+
+} // End of namespace Common
+
+#endif
@@ -25,9 +25,20 @@
 #include "common/memstream.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 
 namespace Common {
 
+/**
+ * Decoding results of all possible next 8 bits of input for one of the
+ * Huffman trees, so that most symbols are decoded with a single lookup.
+ */
+struct HuffmanLookup {
+	uint16 value;	///< decoded value, or the tree node to continue at
+	byte bits;		///< number of bits used
+	bool leaf;		///< whether value is the decoded value
+};
+
 class DecompressorDCL {
 public:
 	bool unpack(ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked);
@@ -59,13 +70,24 @@ protected:
 
 	void fetchBitsLSB();
 
+	/**
+	 * Get the next byte of packed data, which is read from _src in blocks.
+	 */
+	byte getInputByte() {
+		if (_inputPos == _inputSize && !refillInput())
+			return _src->readByte();
+		return _inputBuffer[_inputPos++];
+	}
+
+	bool refillInput();
+
 	/**
 	 * Write one byte into _dest stream
 	 * @param b byte to put
 	 */
 	void putByte(byte b);
 
-	int huffman_lookup(const int *tree);
+	int huffman_lookup(const int *tree, const HuffmanLookup *lookup);
 
 	uint32 _dwBits;		///< bits buffer
 	byte _nBits;		///< number of unread bits in _dwBits
@@ -75,6 +97,13 @@ protected:
 	uint32 _dwWrote;	///< number of bytes written to _dest
 	ReadStream *_src;
 	byte *_dest;
+
+	enum {
+		kInputBufferSize = 4096
+	};
+	byte _inputBuffer[kInputBufferSize];	///< packed data read ahead from _src
+	uint32 _inputPos;	///< position of the next byte in _inputBuffer
+	uint32 _inputSize;	///< number of valid bytes in _inputBuffer
 };
 
 void DecompressorDCL::init(ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked) {
@@ -85,11 +114,20 @@ void DecompressorDCL::init(ReadStream *src, byte *dest, uint32 nPacked, uint32 n
 	_nBits = 0;
 	_dwRead = _dwWrote = 0;
 	_dwBits = 0;
+	_inputPos = _inputSize = 0;
+}
+
+bool DecompressorDCL::refillInput() {
+	// Never read ahead past the packed data
+	uint32 remaining = (_dwRead < _szPacked) ? _szPacked - _dwRead : 0;
+	_inputPos = 0;
+	_inputSize = remaining ? _src->read(_inputBuffer, MIN<uint32>(remaining, kInputBufferSize)) : 0;
+	return _inputSize != 0;
 }
 
 void DecompressorDCL::fetchBitsLSB() {
 	while (_nBits <= 24) {
-		_dwBits |= ((uint32)_src->readByte()) << _nBits;
+		_dwBits |= ((uint32)getInputByte()) << _nBits;
 		_nBits += 8;
 		_dwRead++;
 	}
@@ -316,8 +354,41 @@ static const int ascii_tree[] = {
 	LN(509, 128)      LN(510, 26)
 };
 
-int DecompressorDCL::huffman_lookup(const int *tree) {
-	int pos = 0;
+// The trees are fixed, so their lookup tables are only built once
+static HuffmanLookup s_lengthLookup[256];
+static HuffmanLookup s_distanceLookup[256];
+static HuffmanLookup s_asciiLookup[256];
+static bool s_lookupsBuilt = false;
+
+static void buildHuffmanLookup(const int *tree, HuffmanLookup *lookup) {
+	for (int bits = 0; bits < 256; bits++) {
+		int pos = 0;
+		int n;
+
+		for (n = 0; n < 8 && !(tree[pos] & HUFFMAN_LEAF); n++)
+			pos = (bits & (1 << n)) ? tree[pos] & 0xFFF : tree[pos] >> 12;
+
+		lookup[bits].leaf = (tree[pos] & HUFFMAN_LEAF) != 0;
+		lookup[bits].value = lookup[bits].leaf ? (tree[pos] & 0xFFFF) : pos;
+		lookup[bits].bits = n;
+	}
+}
+
+int DecompressorDCL::huffman_lookup(const int *tree, const HuffmanLookup *lookup) {
+	if (_nBits < 8)
+		fetchBitsLSB();
+
+	const HuffmanLookup &entry = lookup[_dwBits & 0xFF];
+	_dwBits >>= entry.bits;
+	_nBits -= entry.bits;
+
+	if (entry.leaf) {
+		debug(8, "=%02x\n", entry.value);
+		return entry.value;
+	}
+
+	// Codes longer than 8 bits are decoded bit by bit from here on
+	int pos = entry.value;
 
 	while (!(tree[pos] & HUFFMAN_LEAF)) {
 		int bit = getBitsLSB(1);
@@ -349,9 +420,16 @@ bool DecompressorDCL::unpack(ReadStream *src, byte *dest, uint32 nPacked, uint32
 	if (length_param < 3 || length_param > 6)
 		warning("Unexpected length_param value %d (expected in [3,6])", length_param);
 
+	if (!s_lookupsBuilt) {
+		buildHuffmanLookup(length_tree, s_lengthLookup);
+		buildHuffmanLookup(distance_tree, s_distanceLookup);
+		buildHuffmanLookup(ascii_tree, s_asciiLookup);
+		s_lookupsBuilt = true;
+	}
+
 	while (_dwWrote < _szUnpacked) {
 		if (getBitsLSB(1)) { // (length,distance) pair
-			value = huffman_lookup(length_tree);
+			value = huffman_lookup(length_tree, s_lengthLookup);
 
 			if (value < 8)
 				val_length = value + 2;
@@ -360,7 +438,7 @@ bool DecompressorDCL::unpack(ReadStream *src, byte *dest, uint32 nPacked, uint32
 
 			debug(8, " | ");
 
-			value = huffman_lookup(distance_tree);
+			value = huffman_lookup(distance_tree, s_distanceLookup);
 
 			if (val_length == 2)
 				val_distance = (value << 2) | getBitsLSB(2);
@@ -396,7 +474,7 @@ bool DecompressorDCL::unpack(ReadStream *src, byte *dest, uint32 nPacked, uint32
 			}
 
 		} else { // Copy byte verbatim
-			value = (mode == DCL_ASCII_MODE) ? huffman_lookup(ascii_tree) : getByteLSB();
+			value = (mode == DCL_ASCII_MODE) ? huffman_lookup(ascii_tree, s_asciiLookup) : getByteLSB();
 			putByte(value);
 			debug(9, "\33[32;31m%02x \33[37;37m", value);
 		}
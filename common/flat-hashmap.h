@@ -0,0 +1,542 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/func.h"
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap<Key,Val> which
+ * keeps its entries inline in one array instead of allocating a node for
+ * each of them.
+ *
+ * Every slot also stores the full hash value of its entry. Probing walks the
+ * slots linearly and only calls the equality functor for slots whose stored
+ * hash matches, and growing the table never has to call the hash functor
+ * again. Erased entries leave a marker behind
+ * just like in HashMap, so erasing entries while iterating is safe and
+ * iterators to other entries stay valid.
+ *
+ * Unlike with HashMap, entries move when the table grows. Pointers or
+ * references to keys and values are invalidated by inserting new keys.
+ *
+ * Since the slots are stored inline, each empty slot costs
+ * sizeof(Key) + sizeof(Val) bytes. Prefer HashMap for maps with big values
+ * or for many small maps which are mostly empty.
+ *
+ * The requirements on Key, Val, HashFunc and EqualFunc are the same as for
+ * HashMap.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> HM_t;
+
+	struct Node {
+		const Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+	};
+
+	struct Slot {
+		size_type _hash;	///< Stored hash of the entry, or one of the markers below.
+		Node _node;		///< Only constructed while the slot is in use.
+	};
+
+	enum {
+		// Markers stored in Slot::_hash; real hash values are moved out of
+		// this range by storedHash().
+		FLATHASHMAP_EMPTY = 0,
+		FLATHASHMAP_DELETED = 1,
+		FLATHASHMAP_FIRST_HASH = 2,
+
+		FLATHASHMAP_MIN_CAPACITY = 16,
+		FLATHASHMAP_MIN_CAPACITY_SHIFT = 4,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage may fill up (erased entries included) before
+		// it is rebuilt.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 2,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 3
+	};
+
+	Slot *_slots;		///< Storage for _mask + 1 slots.
+	size_type _mask;	///< Capacity of the map minus one; capacity is a power of two.
+	size_type _shift;	///< 32 minus log2 of the capacity, see homeSlot().
+	size_type _size;
+	size_type _deleted;	///< Number of slots marked as FLATHASHMAP_DELETED.
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+	size_type storedHash(const Key &key) const {
+		const size_type hash = _hash(key);
+		return hash < FLATHASHMAP_FIRST_HASH ? hash + FLATHASHMAP_FIRST_HASH : hash;
+	}
+
+	/**
+	 * Pick the first slot to probe for a hash. Many of the hash functors in
+	 * use (e.g. the one for integers) return their input unchanged, so the
+	 * hash is scrambled by a Fibonacci multiplication and the top bits are
+	 * used. This keeps linear probing from piling up regular keys.
+	 */
+	size_type homeSlot(size_type hash) const {
+		return (size_type)(hash * 2654435769U) >> _shift;
+	}
+
+	bool isUsed(size_type idx) const {
+		return _slots[idx]._hash >= FLATHASHMAP_FIRST_HASH;
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const HM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rebuildStorage(size_type newCapacity);
+	void eraseSlot(size_type idx);
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != 0);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isUsed(_idx));
+			return &_hashmap->_slots[_idx]._node;
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(0) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !_hashmap->isUsed(_idx));
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const HM_t &map);
+	~FlatHashMap();
+
+	HM_t &operator=(const HM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isUsed(ctr))
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isUsed(ctr))
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator	find(const Key &key) const {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const HM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Internal method allocating empty storage for the given number of slots,
+ * which must be a power of two. The previous storage is not freed.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+	_mask = capacity - 1;
+	_shift = 32 - FLATHASHMAP_MIN_CAPACITY_SHIFT;
+	for (size_type c = FLATHASHMAP_MIN_CAPACITY; c < capacity; c <<= 1)
+		_shift--;
+
+	// The nodes are constructed in place when a slot gets used.
+	_slots = (Slot *)malloc(capacity * sizeof(Slot));
+	assert(_slots != NULL);
+	for (size_type ctr = 0; ctr < capacity; ++ctr)
+		_slots[ctr]._hash = FLATHASHMAP_EMPTY;
+
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Internal method releasing the storage. All nodes must have been
+ * destroyed already.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	free(_slots);
+	_slots = 0;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const HM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slot layout only depends on the stored hashes, so the table
+	// can be cloned slot by slot.
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		_slots[ctr]._hash = map._slots[ctr]._hash;
+		if (isUsed(ctr)) {
+			new (&_slots[ctr]._node) Node(map._slots[ctr]._node);
+			_size++;
+		} else if (_slots[ctr]._hash == FLATHASHMAP_DELETED) {
+			_deleted++;
+		}
+	}
+	// Perform a sanity check (to help track down hashmap corruption)
+	assert(_size == map._size);
+	assert(_deleted == map._deleted);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(ctr))
+			_slots[ctr]._node.~Node();
+		_slots[ctr]._hash = FLATHASHMAP_EMPTY;
+	}
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	}
+
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Move all entries into fresh storage with the given capacity. This also
+ * drops all erased markers. The stored hashes are reused, so the hash
+ * functor is not called.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rebuildStorage(size_type newCapacity) {
+	const size_type old_size = _size;
+	const size_type old_mask = _mask;
+	Slot *old_slots = _slots;
+
+	allocStorage(newCapacity);
+	assert(old_size * FLATHASHMAP_LOADFACTOR_DENOMINATOR <= newCapacity * FLATHASHMAP_LOADFACTOR_NUMERATOR);
+
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		const size_type hash = old_slots[ctr]._hash;
+		if (hash < FLATHASHMAP_FIRST_HASH)
+			continue;
+
+		// No key exists twice in the old table and there are no erased
+		// slots in the new one, so the first empty slot is the right one.
+		size_type idx = homeSlot(hash);
+		while (_slots[idx]._hash != FLATHASHMAP_EMPTY)
+			idx = (idx + 1) & _mask;
+
+		new (&_slots[idx]._node) Node(old_slots[ctr]._node);
+		old_slots[ctr]._node.~Node();
+		_slots[idx]._hash = hash;
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	assert(_size == old_size);
+
+	free(old_slots);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const size_type hash = storedHash(key);
+	for (size_type ctr = homeSlot(hash); ; ctr = (ctr + 1) & _mask) {
+		const size_type slotHash = _slots[ctr]._hash;
+		if (slotHash == FLATHASHMAP_EMPTY)
+			return _mask + 1;
+		if (slotHash == hash && _equal(_slots[ctr]._node._key, key))
+			return ctr;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const size_type hash = storedHash(key);
+	const size_type NONE_FOUND = _mask + 1;
+	size_type first_free = NONE_FOUND;
+	size_type ctr;
+	for (ctr = homeSlot(hash); ; ctr = (ctr + 1) & _mask) {
+		const size_type slotHash = _slots[ctr]._hash;
+		if (slotHash == FLATHASHMAP_EMPTY)
+			break;
+		if (slotHash == FLATHASHMAP_DELETED) {
+			if (first_free == NONE_FOUND)
+				first_free = ctr;
+		} else if (slotHash == hash && _equal(_slots[ctr]._node._key, key)) {
+			return ctr;
+		}
+	}
+
+	if (first_free != NONE_FOUND) {
+		ctr = first_free;
+		_deleted--;
+	}
+
+	new (&_slots[ctr]._node) Node(key);
+	_slots[ctr]._hash = hash;
+	_size++;
+
+	// Keep the load factor below a certain threshold. Erased slots are
+	// also counted, since they lengthen the probe sequences just the same.
+	// If they make up most of the load, rebuilding at the current size is
+	// enough to get rid of them.
+	size_type capacity = _mask + 1;
+	if ((_size + _deleted) * FLATHASHMAP_LOADFACTOR_DENOMINATOR >
+	        capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		if (_deleted < _size)
+			capacity = capacity < 512 ? (capacity * 4) : (capacity * 2);
+		rebuildStorage(capacity);
+		ctr = lookup(key);
+		assert(ctr <= _mask);
+	}
+
+	return ctr;
+}
+
+/**
+ * Destroy the entry in the given slot. If the next slot is empty, no probe
+ * sequence can run through this slot, so it and the erased slots directly
+ * before it can be marked empty instead of erased.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type idx) {
+	assert(isUsed(idx));
+	_slots[idx]._node.~Node();
+	_size--;
+
+	if (_slots[(idx + 1) & _mask]._hash != FLATHASHMAP_EMPTY) {
+		_slots[idx]._hash = FLATHASHMAP_DELETED;
+		_deleted++;
+		return;
+	}
+
+	_slots[idx]._hash = FLATHASHMAP_EMPTY;
+	idx = (idx - 1) & _mask;
+	while (_slots[idx]._hash == FLATHASHMAP_DELETED) {
+		_slots[idx]._hash = FLATHASHMAP_EMPTY;
+		_deleted--;
+		idx = (idx - 1) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) <= _mask;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._node._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _slots[ctr]._node._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._node._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	assert(entry._idx <= _mask);
+	eraseSlot(entry._idx);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		eraseSlot(ctr);
+}
+
+}	// End of namespace Common
+
+#endif
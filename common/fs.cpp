@@ -190,8 +190,25 @@ FSNode *FSDirectory::lookupCache(NodeCache &cache, const String &name) const {
 	if (!name.empty()) {
 		ensureCached();
 
-		if (cache.contains(name))
-			return &cache[name];
+		// Cache the sub-directories leading to the name, as far as they
+		// have not been needed before.
+		if (!_pendingDirs.empty()) {
+			const char *path = name.c_str();
+			for (const char *sep = strchr(path, '/'); sep; sep = strchr(sep + 1, '/')) {
+				const Atom dir = Atom::find(String(path, sep));
+				if (!dir.isNull())
+					cacheSubDirectory(dir);
+			}
+		}
+
+		// All cached names are interned, so a name which is not
+		// interned cannot be in the cache.
+		const Atom key = Atom::find(name);
+		if (!key.isNull()) {
+			NodeCache::iterator it = cache.find(key);
+			if (it != cache.end())
+				return &it->_value;
+		}
 	}
 
 	return 0;
@@ -251,7 +268,7 @@ FSDirectory *FSDirectory::getSubDirectory(const String &prefix, const String &na
 	return new FSDirectory(prefix, *node, depth, flat);
 }
 
-void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String& prefix) const {
+void FSDirectory::cacheDirectory(const FSNode &node, int depth, const String &prefix) const {
 	if (depth <= 0)
 		return;
 
@@ -262,55 +279,81 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String&
 	for ( ; it != list.end(); ++it) {
 		String name = prefix + it->getName();
 
-		// don't touch name as it might be used for warning messages
-		String lowercaseName = name;
-		lowercaseName.toLowercase();
+		// atoms are case insensitive, so this also finds clashes in case
+		const Atom key(name);
 
 		// since the hashmap is case insensitive, we need to check for clashes when caching
 		if (it->isDirectory()) {
-			if (!_flat && _subDirCache.contains(lowercaseName)) {
+			if (!_flat && _subDirCache.contains(key)) {
 				warning("FSDirectory::cacheDirectory: name clash when building cache, ignoring sub-directory '%s'", name.c_str());
 			} else {
-				if (_subDirCache.contains(lowercaseName)) {
+				if (_subDirCache.contains(key)) {
 					warning("FSDirectory::cacheDirectory: name clash when building subDirCache with subdirectory '%s'", name.c_str());
 				}
-				cacheDirectoryRecursive(*it, depth - 1, _flat ? prefix : lowercaseName + "/");
-				_subDirCache[lowercaseName] = *it;
+				// In a flat cache any lookup can end up in any sub-directory,
+				// so they all have to be read right away. Otherwise they are
+				// read when a lookup goes through them.
+				if (_flat) {
+					cacheDirectory(*it, depth - 1, prefix);
+				} else if (depth > 1) {
+					PendingDir &pending = _pendingDirs[key];
+					pending.depth = depth - 1;
+					pending.prefix = name + "/";
+				}
+				_subDirCache[key] = *it;
 			}
 		} else {
-			if (_fileCache.contains(lowercaseName)) {
+			if (_fileCache.contains(key)) {
 				warning("FSDirectory::cacheDirectory: name clash when building cache, ignoring file '%s'", name.c_str());
 			} else {
-				_fileCache[lowercaseName] = *it;
+				_fileCache[key] = *it;
 			}
 		}
 	}
 
 }
 
+void FSDirectory::cacheSubDirectory(const Atom &key) const {
+	PendingDirs::iterator it = _pendingDirs.find(key);
+	if (it == _pendingDirs.end())
+		return;
+
+	// Caching may add to both maps, so take copies first
+	const PendingDir pending = it->_value;
+	_pendingDirs.erase(it);
+	const FSNode node = _subDirCache[key];
+
+	cacheDirectory(node, pending.depth, pending.prefix);
+}
+
 void FSDirectory::ensureCached() const  {
 	if (_cached)
 		return;
-	cacheDirectoryRecursive(_node, _depth, _prefix);
+	cacheDirectory(_node, _depth, _prefix);
 	_cached = true;
 }
 
+void FSDirectory::ensureFullyCached() const {
+	ensureCached();
+	while (!_pendingDirs.empty()) {
+		const Atom key = _pendingDirs.begin()->_key;
+		cacheSubDirectory(key);
+	}
+}
+
 int FSDirectory::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
 	if (!_node.isDirectory())
 		return 0;
 
 	// Cache dir data
-	ensureCached();
-
-	// need to match lowercase key, since all entries in our file cache are
-	// stored as lowercase.
-	String lowercasePattern(pattern);
-	lowercasePattern.toLowercase();
+	ensureFullyCached();
 
+	// atoms keep the spelling they were first interned with, so the
+	// keys have to be matched case insensitively.
 	int matches = 0;
 	NodeCache::const_iterator it = _fileCache.begin();
 	for ( ; it != _fileCache.end(); ++it) {
-		if (it->_key.matchString(lowercasePattern, false, true)) {
+		if (it->_key.toString().matchString(pattern, true, true)) {
 			list.push_back(ArchiveMemberPtr(new FSNode(it->_value)));
 			matches++;
 		}
@@ -323,7 +366,7 @@ int FSDirectory::listMembers(ArchiveMemberList &list) const {
 		return 0;
 
 	// Cache dir data
-	ensureCached();
+	ensureFullyCached();
 
 	int files = 0;
 	for (NodeCache::const_iterator it = _fileCache.begin(); it != _fileCache.end(); ++it) {
@@ -24,6 +24,7 @@
 
 #include "common/array.h"
 #include "common/archive.h"
+#include "common/atom.h"
 #include "common/hash-str.h"
 #include "common/hashmap.h"
 #include "common/ptr.h"
@@ -264,23 +265,39 @@ class FSDirectory : public Archive {
 	String	_prefix;	// string that is prepended to each cache item key
 	void setPrefix(const String &prefix);
 
-	// Caches are case insensitive, clashes are dealt with when creating
-	// Key is stored in lowercase.
-	typedef HashMap<String, FSNode, IgnoreCase_Hash, IgnoreCase_EqualTo> NodeCache;
+	// Caches are case insensitive, clashes are dealt with when creating.
+	// Keys are atoms, so that names which were never interned can be
+	// rejected without probing the caches.
+	typedef HashMap<Atom, FSNode> NodeCache;
 	mutable NodeCache	_fileCache, _subDirCache;
 	mutable bool _cached;
 	mutable int	_depth;
 	mutable bool _flat;
 
+	// Sub-directories which are in _subDirCache but whose contents have
+	// not been cached yet, together with the depth left to cache them to
+	// and the prefix of their entries.
+	struct PendingDir {
+		int depth;
+		String prefix;
+	};
+	typedef HashMap<Atom, PendingDir> PendingDirs;
+	mutable PendingDirs _pendingDirs;
+
 	// look for a match
 	FSNode *lookupCache(NodeCache &cache, const String &name) const;
 
 	// cache management
-	void cacheDirectoryRecursive(FSNode node, int depth, const String& prefix) const;
+	void cacheDirectory(const FSNode &node, int depth, const String &prefix) const;
+	void cacheSubDirectory(const Atom &key) const;
 
-	// fill cache if not already cached
+	// fill cache if not already cached, sub-directories are only cached
+	// once a lookup needs them
 	void ensureCached() const;
 
+	// fill cache including all pending sub-directories
+	void ensureFullyCached() const;
+
 public:
 	/**
 	 * Create a FSDirectory representing a tree with the specified depth. Will result in an
@@ -23,6 +23,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
 
 #include "common/system.h"
+#include "common/atom.h"
 #include "common/events.h"
 #include "common/fs.h"
 #include "common/savefile.h"
@@ -79,6 +80,9 @@ OSystem::~OSystem() {
 }
 
 void OSystem::initBackend() {
+	// Atoms are shared by all threads, so they have to be locked from now on
+	Common::Atom::initLocking();
+
 	// Verify all managers has been set
 	if (!_audiocdManager)
 		error("Backend failed to instantiate audio CD manager");
@@ -33,6 +33,7 @@
 #include "sci/engine/savegame.h"
 #include "sci/engine/gc.h"
 #include "sci/engine/features.h"
+#include "sci/engine/pathfinding.h"
 #include "sci/sound/midiparser_sci.h"
 #include "sci/sound/music.h"
 #include "sci/sound/drivers/mididriver.h"
@@ -94,6 +95,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("selectors",			WRAP_METHOD(Console, cmdSelectors));
 	DCmd_Register("functions",			WRAP_METHOD(Console, cmdKernelFunctions));
 	DCmd_Register("class_table",		WRAP_METHOD(Console, cmdClassTable));
+	DCmd_Register("avoidpath_record",	WRAP_METHOD(Console, cmdAvoidPathRecord));
+	DCmd_Register("avoidpath_bench",	WRAP_METHOD(Console, cmdAvoidPathBench));
 	// Parser
 	DCmd_Register("suffixes",			WRAP_METHOD(Console, cmdSuffixes));
 	DCmd_Register("parse_grammar",		WRAP_METHOD(Console, cmdParseGrammar));
@@ -112,6 +115,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("list",				WRAP_METHOD(Console, cmdList));
 	DCmd_Register("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	DCmd_Register("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
+	DCmd_Register("bench_decompression",	WRAP_METHOD(Console, cmdBenchDecompression));
 	// Game
 	DCmd_Register("save_game",			WRAP_METHOD(Console, cmdSaveGame));
 	DCmd_Register("restore_game",		WRAP_METHOD(Console, cmdRestoreGame));
@@ -124,6 +128,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("show_map",			WRAP_METHOD(Console, cmdShowMap));
 	DCmd_Register("set_palette",		WRAP_METHOD(Console, cmdSetPalette));
 	DCmd_Register("draw_pic",			WRAP_METHOD(Console, cmdDrawPic));
+	DCmd_Register("bench_pics",			WRAP_METHOD(Console, cmdBenchPics));
 	DCmd_Register("draw_cel",			WRAP_METHOD(Console, cmdDrawCel));
 	DCmd_Register("undither",           WRAP_METHOD(Console, cmdUndither));
 	DCmd_Register("pic_visualize",		WRAP_METHOD(Console, cmdPicVisualize));
@@ -136,6 +141,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("pl",                 WRAP_METHOD(Console, cmdPlaneList));	// alias
 	DCmd_Register("plane_items",        WRAP_METHOD(Console, cmdPlaneItemList));
 	DCmd_Register("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
+	DCmd_Register("show_redraw",        WRAP_METHOD(Console, cmdShowRedraw));
+	DCmd_Register("frame_stats",        WRAP_METHOD(Console, cmdFrameStats));
 	DCmd_Register("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	DCmd_Register("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
 	// Segments
@@ -332,6 +339,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" selector - Attempts to find the requested selector by name\n");
 	DebugPrintf(" functions - Lists the kernel functions\n");
 	DebugPrintf(" class_table - Shows the available classes\n");
+	DebugPrintf(" avoidpath_record - Starts or stops recording the calls to kAvoidPath\n");
+	DebugPrintf(" avoidpath_bench - Replays the recorded kAvoidPath calls and reports the time needed\n");
 	DebugPrintf("\n");
 	DebugPrintf("Parser:\n");
 	DebugPrintf(" suffixes - Lists the vocabulary suffixes\n");
@@ -352,6 +361,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" list - Lists all the resources of a given type\n");
 	DebugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	DebugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
+	DebugPrintf(" bench_decompression - Decompresses all resources and reports the speed of each compression method\n");
 	DebugPrintf("\n");
 	DebugPrintf("Game:\n");
 	DebugPrintf(" save_game - Saves the current game state to the hard disk\n");
@@ -366,6 +376,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" show_map - Switches to visual, priority, control or display screen\n");
 	DebugPrintf(" set_palette - Sets a palette resource\n");
 	DebugPrintf(" draw_pic - Draws a pic resource\n");
+	DebugPrintf(" bench_pics - Draws all pic resources and reports the time needed\n");
 	DebugPrintf(" draw_cel - Draws a cel from a view resource\n");
 	DebugPrintf(" pic_visualize - Enables visualization of the drawing process of EGA pictures\n");
 	DebugPrintf(" undither - Enable/disable undithering\n");
@@ -373,6 +384,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" animate_list / al - Shows the current list of objects in kAnimate's draw list (SCI0 - SCI1.1)\n");
 	DebugPrintf(" window_list / wl - Shows a list of all the windows (ports) in the draw list (SCI0 - SCI1.1)\n");
 	DebugPrintf(" plane_list / pl - Shows a list of all the planes in the draw list (SCI2+)\n");
+	DebugPrintf(" show_redraw - Highlights the screen areas redrawn in each frame (SCI2+)\n");
+	DebugPrintf(" frame_stats - Shows how much of the screen got redrawn (SCI2+)\n");
 	DebugPrintf(" saved_bits - List saved bits on the hunk\n");
 	DebugPrintf(" show_saved_bits - Display saved bits\n");
 	DebugPrintf("\n");
@@ -792,6 +805,44 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdBenchDecompression(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("Decompresses all resources in the resource volumes and reports the speed\n");
+		DebugPrintf("of each compression method\n");
+		DebugPrintf("Usage: %s [<repetitions>]\n", argv[0]);
+		return true;
+	}
+
+	int repetitions = (argc == 2) ? atoi(argv[1]) : 1;
+	if (repetitions < 1)
+		repetitions = 1;
+
+	static const char *const compressionNames[] = {
+		"none", "LZW", "Huffman", "LZW1", "LZW1 view", "LZW1 pic",
+#ifdef ENABLE_SCI32
+		"STACpack",
+#endif
+		"DCL"
+	};
+
+	ResourceManager::DecompressionStats stats[kCompDCL + 1];
+	_engine->getResMan()->benchmarkDecompression(stats, repetitions);
+
+	for (int i = 0; i <= kCompDCL; i++) {
+		if (!stats[i].resources)
+			continue;
+
+		DebugPrintf("%-10s %5d resources, %7d KB packed, %7d KB unpacked, %6d ms",
+				compressionNames[i], stats[i].resources, stats[i].packedSize / 1024,
+				stats[i].unpackedSize / 1024, stats[i].time);
+		if (stats[i].time)
+			DebugPrintf(", %.2f MB/s", (double)stats[i].unpackedSize * repetitions / stats[i].time * 1000 / (1024 * 1024));
+		DebugPrintf("\n");
+	}
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		DebugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -1500,6 +1551,7 @@ bool Console::cmdDrawPic(int argc, const char **argv) {
 	_engine->_gfxPaint->kernelDrawPicture(resourceId, 100, false, false, false, 0);
 	_engine->_gfxScreen->copyToScreen();
 	_engine->sleep(2000);
+	forceFullRedraw();
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	// Show the graphical debugger overlay
@@ -1509,6 +1561,69 @@ bool Console::cmdDrawPic(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdBenchPics(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("Draws all pic resources of the game and reports the time needed\n");
+		DebugPrintf("Usage: %s [<repetitions>]\n", argv[0]);
+		return true;
+	}
+
+	int repetitions = (argc == 2) ? atoi(argv[1]) : 1;
+	if (repetitions < 1)
+		repetitions = 1;
+
+	Common::List<ResourceId> resources = _engine->getResMan()->listResources(kResourceTypePic);
+	Common::sort(resources.begin(), resources.end());
+
+	DebugPrintf("Drawing %d pic resources %d time(s)...\n", resources.size(), repetitions);
+
+	// Drawing pictures overwrites the screens and the palette, save them
+	// so that the game continues undisturbed afterwards
+	GfxScreen *screen = _engine->_gfxScreen;
+	Common::Rect screenRect(screen->getWidth(), screen->getHeight());
+	byte *savedScreens = new byte[screen->bitsGetDataSize(screenRect, GFX_SCREEN_MASK_ALL)];
+	screen->bitsSave(screenRect, GFX_SCREEN_MASK_ALL, savedScreens);
+	Palette savedPalette;
+	_engine->_gfxPalette->getSys(&savedPalette);
+
+	uint32 totalTime = 0;
+	uint32 slowestTime = 0;
+	uint16 slowestPic = 0;
+	Common::List<ResourceId>::iterator itr;
+	for (itr = resources.begin(); itr != resources.end(); ++itr) {
+		// Load the resource beforehand, so that only drawing gets measured
+		if (!_engine->getResMan()->findResource(*itr, false)) {
+			DebugPrintf("Error: pic %d couldn't be loaded\n", itr->getNumber());
+			continue;
+		}
+
+		uint32 startTime = g_system->getMillis();
+		for (int i = 0; i < repetitions; i++)
+			_engine->_gfxPaint->kernelDrawPicture(itr->getNumber(), 100, false, false, false, 0);
+		uint32 picTime = g_system->getMillis() - startTime;
+
+		totalTime += picTime;
+		if (picTime > slowestTime) {
+			slowestTime = picTime;
+			slowestPic = itr->getNumber();
+		}
+	}
+
+	DebugPrintf("Total: %d ms", totalTime);
+	if (!resources.empty())
+		DebugPrintf(", %d.%02d ms per pic", totalTime / (resources.size() * repetitions),
+					(totalTime * 100 / (resources.size() * repetitions)) % 100);
+	DebugPrintf("\nSlowest: pic %d with %d ms\n", slowestPic, slowestTime);
+
+	screen->bitsRestore(savedScreens);
+	delete[] savedScreens;
+	_engine->_gfxPalette->_sysPalette = savedPalette;
+	_engine->_gfxPalette->setOnScreen();
+	screen->copyToScreen();
+	forceFullRedraw();
+	return true;
+}
+
 bool Console::cmdDrawCel(int argc, const char **argv) {
 	if (argc < 4) {
 		DebugPrintf("Draws a cel from a view resource\n");
@@ -1528,10 +1643,18 @@ bool Console::cmdDrawCel(int argc, const char **argv) {
 		Common::Rect celRect(50, 50, 50 + view->getWidth(loopNo, celNo), 50 + view->getHeight(loopNo, celNo));
 		view->draw(celRect, celRect, celRect, loopNo, celNo, 255, 0, false);
 		_engine->_gfxScreen->copyRectToScreen(celRect);
+		forceFullRedraw();
 	}
 	return true;
 }
 
+void Console::forceFullRedraw() {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout)
+		_engine->_gfxFrameout->forceFullRedraw();
+#endif
+}
+
 bool Console::cmdUndither(int argc, const char **argv) {
 	if (argc != 2) {
 		DebugPrintf("Enable/disable undithering.\n");
@@ -1654,6 +1777,43 @@ bool Console::cmdPlaneItemList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdShowRedraw(int argc, const char **argv) {
+	if (argc != 2) {
+		DebugPrintf("Enable/disable highlighting of the screen areas redrawn in each frame.\n");
+		DebugPrintf("Usage: %s <0/1>\n", argv[0]);
+		return true;
+	}
+
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		bool flag = atoi(argv[1]) ? true : false;
+		_engine->_gfxFrameout->setShowRedrawRects(flag);
+		if (flag)
+			DebugPrintf("redraw highlighting ENABLED\n");
+		else
+			DebugPrintf("redraw highlighting DISABLED\n");
+	} else {
+		DebugPrintf("This SCI version does not use kFrameout\n");
+	}
+#else
+	DebugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
+bool Console::cmdFrameStats(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		_engine->_gfxFrameout->printFrameStats(this);
+	} else {
+		DebugPrintf("This SCI version does not use kFrameout\n");
+	}
+#else
+	DebugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdSavedBits(int argc, const char **argv) {
 	SegManager *segman = _engine->_gamestate->_segMan;
 	SegmentId id = segman->findSegmentByType(SEG_TYPE_HUNK);
@@ -2081,6 +2241,7 @@ bool Console::cmdShowMap(int argc, const char **argv) {
 	case 2:
 	case 3:
 		_engine->_gfxScreen->debugShowMap(map);
+		forceFullRedraw();
 		break;
 
 	default:
@@ -3603,6 +3764,61 @@ bool Console::cmdQuit(int argc, const char **argv) {
 	return Cmd_Exit(0, 0);
 }
 
+bool Console::cmdAvoidPathRecord(int argc, const char **argv) {
+	if (argc != 2) {
+		DebugPrintf("Starts or stops recording the calls to kAvoidPath, for use with avoidpath_bench\n");
+		DebugPrintf("Usage: %s <0/1>\n", argv[0]);
+		DebugPrintf("Starting a recording discards the previously recorded calls. The recording\n");
+		DebugPrintf("stops by itself after %d calls\n", PATHFINDING_MAX_RECORDED_QUERIES);
+		return true;
+	}
+
+	PathfindingCache *cache = getPathfindingCache(_engine->_gamestate);
+	cache->recording = atoi(argv[1]) != 0;
+	if (cache->recording)
+		cache->queries.clear();
+	else
+		DebugPrintf("%d calls recorded\n", cache->queries.size());
+
+	return true;
+}
+
+bool Console::cmdAvoidPathBench(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("Replays the calls to kAvoidPath recorded with avoidpath_record, with and\n");
+		DebugPrintf("without the visibility graph cache, and reports the time needed\n");
+		DebugPrintf("Usage: %s [<repetitions>]\n", argv[0]);
+		return true;
+	}
+
+	int repetitions = (argc == 2) ? atoi(argv[1]) : 1;
+	if (repetitions < 1)
+		repetitions = 1;
+
+	PathfindingCache *cache = getPathfindingCache(_engine->_gamestate);
+	uint32 times[2];
+	int unreachable = 0;
+
+	for (int pass = 0; pass < 2; pass++) {
+		// The first pass runs without cache, the second one starts with an empty cache
+		cache->enabled = (pass == 1);
+		for (int i = 0; i < PATHFINDING_CACHE_SIZE; i++)
+			cache->entries[i] = PathfindingCacheEntry();
+		cache->hits = cache->misses = 0;
+
+		uint32 startTime = g_system->getMillis();
+		unreachable = replayAvoidPathQueries(_engine->_gamestate, repetitions);
+		times[pass] = g_system->getMillis() - startTime;
+	}
+
+	cache->enabled = true;
+
+	DebugPrintf("%d recorded calls (%d unreachable), %d repetition(s)\n", cache->queries.size(), unreachable, repetitions);
+	DebugPrintf("Without cache: %d ms\n", times[0]);
+	DebugPrintf("With cache: %d ms (%d hits, %d misses)\n", times[1], cache->hits, cache->misses);
+	return true;
+}
+
 bool Console::cmdAddresses(int argc, const char **argv) {
 	DebugPrintf("Address parameters may be passed in one of three forms:\n");
 	DebugPrintf(" - ssss:oooo -- where 'ssss' denotes a segment and 'oooo' an offset.\n");
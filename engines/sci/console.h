@@ -72,6 +72,7 @@ private:
 	bool cmdResourceId(int argc, const char **argv);
 	bool cmdResourceInfo(int argc, const char **argv);
 	bool cmdResourceTypes(int argc, const char **argv);
+	bool cmdBenchDecompression(int argc, const char **argv);
 	bool cmdList(int argc, const char **argv);
 	bool cmdHexgrep(int argc, const char **argv);
 	bool cmdVerifyScripts(int argc, const char **argv);
@@ -83,11 +84,14 @@ private:
 	bool cmdRoomNumber(int argc, const char **argv);
 	bool cmdQuit(int argc, const char **argv);
 	bool cmdListSaves(int argc, const char **argv);
+	bool cmdAvoidPathRecord(int argc, const char **argv);
+	bool cmdAvoidPathBench(int argc, const char **argv);
 	// Screen
 	bool cmdShowMap(int argc, const char **argv);
 	// Graphics
 	bool cmdSetPalette(int argc, const char **argv);
 	bool cmdDrawPic(int argc, const char **argv);
+	bool cmdBenchPics(int argc, const char **argv);
 	bool cmdDrawCel(int argc, const char **argv);
 	bool cmdUndither(int argc, const char **argv);
 	bool cmdPicVisualize(int argc, const char **argv);
@@ -96,6 +100,8 @@ private:
 	bool cmdWindowList(int argc, const char **argv);
 	bool cmdPlaneList(int argc, const char **argv);
 	bool cmdPlaneItemList(int argc, const char **argv);
+	bool cmdShowRedraw(int argc, const char **argv);
+	bool cmdFrameStats(int argc, const char **argv);
 	bool cmdSavedBits(int argc, const char **argv);
 	bool cmdShowSavedBits(int argc, const char **argv);
 	// Segments
@@ -173,6 +179,13 @@ private:
 	 */
 	void printKernelCallsFound(int kernelFuncNum, bool showFoundScripts);
 
+	/**
+	 * Makes the next kFrameout redraw the whole screen. Used by commands
+	 * which draw to the screen directly, behind the back of the dirty
+	 * rectangle tracking.
+	 */
+	void forceFullRedraw();
+
 	SciEngine *_engine;
 	DebugState &_debugState;
 	bool _mouseVisible;
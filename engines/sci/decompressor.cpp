@@ -53,11 +53,21 @@ void Decompressor::init(Common::ReadStream *src, byte *dest, uint32 nPacked,
 	_nBits = 0;
 	_dwRead = _dwWrote = 0;
 	_dwBits = 0;
+	_inputPos = _inputSize = 0;
+}
+
+bool Decompressor::refillInput() {
+	// Don't read ahead past the packed data. If the decompressor wants more
+	// than that, it gets it byte by byte from _src, as it always did.
+	uint32 remaining = (_dwRead < _szPacked) ? _szPacked - _dwRead : 0;
+	_inputPos = 0;
+	_inputSize = remaining ? _src->read(_inputBuffer, MIN<uint32>(remaining, kInputBufferSize)) : 0;
+	return _inputSize != 0;
 }
 
 void Decompressor::fetchBitsMSB() {
 	while (_nBits <= 24) {
-		_dwBits |= ((uint32)_src->readByte()) << (24 - _nBits);
+		_dwBits |= ((uint32)getInputByte()) << (24 - _nBits);
 		_nBits += 8;
 		_dwRead++;
 	}
@@ -79,7 +89,7 @@ byte Decompressor::getByteMSB() {
 
 void Decompressor::fetchBitsLSB() {
 	while (_nBits <= 24) {
-		_dwBits |= ((uint32)_src->readByte()) << _nBits;
+		_dwBits |= ((uint32)getInputByte()) << _nBits;
 		_nBits += 8;
 		_dwRead++;
 	}
@@ -116,6 +126,9 @@ int DecompressorHuffman::unpack(Common::ReadStream *src, byte *dest, uint32 nPac
 	terminator = _src->readByte() | 0x100;
 	_nodes = new byte [numnodes << 1];
 	_src->read(_nodes, numnodes << 1);
+	// The header and the nodes are part of the packed data, too
+	_dwRead += 2 + (numnodes << 1);
+	buildLookupTable(numnodes);
 
 	while ((c = getc2()) != terminator && (c >= 0) && !isFinished())
 		putByte(c);
@@ -124,8 +137,55 @@ int DecompressorHuffman::unpack(Common::ReadStream *src, byte *dest, uint32 nPac
 	return _dwWrote == _szUnpacked ? 0 : 1;
 }
 
+void DecompressorHuffman::buildLookupTable(byte numnodes) {
+	for (int bits = 0; bits < 256; bits++) {
+		LookupEntry &entry = _lookup[bits];
+		uint16 node = 0;
+		int n;
+
+		entry.type = kLookupNode;
+		for (n = 0; n < 8 && numnodes; n++) {
+			if (!_nodes[node * 2 + 1]) {
+				entry.type = kLookupLeaf;
+				break;
+			}
+
+			uint16 next;
+			if (bits & (0x80 >> n)) {
+				next = _nodes[node * 2 + 1] & 0x0F;
+				if (next == 0) {
+					n++;
+					entry.type = kLookupEscape;
+					break;
+				}
+			} else
+				next = _nodes[node * 2 + 1] >> 4;
+
+			// Leave broken trees to the bit by bit decoding below
+			if (node + next >= numnodes)
+				break;
+			node += next;
+		}
+
+		entry.bits = n;
+		entry.value = (entry.type == kLookupLeaf) ? _nodes[node * 2] : node;
+	}
+}
+
 int16 DecompressorHuffman::getc2() {
-	byte *node = _nodes;
+	if (_nBits < 8)
+		fetchBitsMSB();
+
+	const LookupEntry &entry = _lookup[_dwBits >> 24];
+	_dwBits <<= entry.bits;
+	_nBits -= entry.bits;
+
+	if (entry.type == kLookupLeaf)
+		return entry.value;
+	if (entry.type == kLookupEscape)
+		return getByteMSB() | 0x100;
+
+	byte *node = _nodes + (entry.value << 1);
 	int16 next;
 	while (node[1]) {
 		if (getBitsMSB(1)) {
@@ -94,6 +94,18 @@ protected:
 	void fetchBitsMSB();
 	void fetchBitsLSB();
 
+	/**
+	 * Get the next byte of packed data. The packed data is read from _src
+	 * in blocks, reading it byte by byte is a lot slower.
+	 */
+	byte getInputByte() {
+		if (_inputPos == _inputSize && !refillInput())
+			return _src->readByte();
+		return _inputBuffer[_inputPos++];
+	}
+
+	bool refillInput();
+
 	/**
 	 * Write one byte into _dest stream
 	 * @param b byte to put
@@ -117,6 +129,13 @@ protected:
 	uint32 _dwWrote;	///< number of bytes written to _dest
 	Common::ReadStream *_src;
 	byte *_dest;
+
+	enum {
+		kInputBufferSize = 4096
+	};
+	byte _inputBuffer[kInputBufferSize];	///< packed data read ahead from _src
+	uint32 _inputPos;	///< position of the next byte in _inputBuffer
+	uint32 _inputSize;	///< number of valid bytes in _inputBuffer
 };
 
 /**
@@ -128,8 +147,26 @@ public:
 
 protected:
 	int16 getc2();
+	void buildLookupTable(byte numnodes);
+
+	enum LookupType {
+		kLookupLeaf,	///< value is the decoded character
+		kLookupEscape,	///< a literal byte follows
+		kLookupNode		///< value is the node to continue decoding at
+	};
+
+	/**
+	 * Decoding results of all possible next 8 bits of input, so that most
+	 * characters can be decoded with a single lookup.
+	 */
+	struct LookupEntry {
+		uint16 value;
+		byte type;
+		byte bits;	///< number of bits used
+	};
 
 	byte *_nodes;
+	LookupEntry _lookup[256];
 };
 
 /**
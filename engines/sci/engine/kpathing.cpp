@@ -27,6 +27,7 @@
 #include "sci/graphics/paint16.h"
 #include "sci/graphics/palette.h"
 #include "sci/graphics/screen.h"
+#include "sci/engine/pathfinding.h"
 
 #include "common/debug-channels.h"
 #include "common/list.h"
@@ -94,10 +95,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Index in the cached visibility graph, -1 if not part of it
+	int graphIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		graphIndex = -1;
 	}
 };
 
@@ -214,6 +219,13 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+// Visibility graph states of a vertex pair
+enum {
+	VIS_UNKNOWN = 0,
+	VIS_VISIBLE = 1,
+	VIS_HIDDEN = 2
+};
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -235,12 +247,16 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Cached visibility graph of the polygon set, NULL if not available
+	PathfindingCacheEntry *_visibility;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
 		vertex_index = NULL;
 		_prependPoint = NULL;
 		_appendPoint = NULL;
+		_visibility = NULL;
 		vertices = 0;
 	}
 
@@ -637,6 +653,34 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Checks if the line between two vertices crosses any polygon edge.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the first vertex
+ * @param vertex		the second vertex
+ * @return true if the vertices can see each other, false otherwise
+ */
+static bool edges_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -645,6 +689,7 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	PathfindingCacheEntry *cache = (vertex_cur->graphIndex >= 0) ? s->_visibility : NULL;
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
@@ -653,26 +698,21 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+		bool visible;
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+		if (cache && vertex->graphIndex >= 0) {
+			// Visibility is symmetric, so both directions get stored at once
+			byte &state = cache->visibility[vertex_cur->graphIndex * cache->vertices + vertex->graphIndex];
+			if (state == VIS_UNKNOWN) {
+				state = edges_visible(s, vertex_cur, vertex) ? VIS_VISIBLE : VIS_HIDDEN;
+				cache->visibility[vertex->graphIndex * cache->vertices + vertex_cur->graphIndex] = state;
 			}
+			visible = (state == VIS_VISIBLE);
+		} else {
+			visible = edges_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1059,8 +1099,10 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				Vertex *next = CLIST_NEXT(vertex);
 
 				if (between(vertex->v, next->v, v)) {
-					// Split edge by adding vertex
+					// Split edge by adding vertex. This changes the edges, so
+					// the cached visibility graph can't be used anymore.
 					polygon->vertices.insertAfter(vertex, v_new);
+					s->_visibility = NULL;
 					return v_new;
 				}
 			}
@@ -1163,41 +1205,120 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+PathfindingCache *getPathfindingCache(EngineState *s) {
+	if (!s->_pathfindingCache)
+		s->_pathfindingCache = new PathfindingCache();
+	return s->_pathfindingCache;
+}
+
 /**
- * Converts the SCI input data for pathfinding
+ * Stores type, vertex count and vertices of all polygons in a flat array
+ * Parameters: (const PolygonList &) polygons: The polygons
+ *             (Common::Array<int16> &) data: The array to fill
+ */
+static void store_polygon_data(const PolygonList &polygons, Common::Array<int16> &data) {
+	data.clear();
+	for (PolygonList::const_iterator it = polygons.begin(); it != polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		data.push_back(polygon->type);
+		data.push_back(polygon->vertices.size());
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			data.push_back(vertex->v.x);
+			data.push_back(vertex->v.y);
+		}
+	}
+}
+
+/**
+ * Creates polygons from an array filled by store_polygon_data()
+ * Parameters: (const Common::Array<int16> &) data: The polygon data
+ *             (PolygonList &) polygons: The list to add the polygons to
+ */
+static void load_polygon_data(const Common::Array<int16> &data, PolygonList &polygons) {
+	uint pos = 0;
+	while (pos + 1 < data.size()) {
+		Polygon *polygon = new Polygon(data[pos]);
+		int size = data[pos + 1];
+		pos += 2;
+
+		// The vertices were stored in list order, insertHead() reverses it
+		for (int i = size - 1; i >= 0; i--)
+			polygon->vertices.insertHead(new Vertex(Common::Point(data[pos + i * 2], data[pos + i * 2 + 1])));
+		pos += size * 2;
+
+		polygons.push_back(polygon);
+	}
+}
+
+/**
+ * Numbers the vertices of the polygon set and looks up its visibility graph
+ * in the cache, replacing the least recently used entry if it isn't there
  * Parameters: (EngineState *) s: The game state
- *             (reg_t) poly_list: Polygon list
- *             (Common::Point) start: The start point
- *             (Common::Point) end: The end point
- *             (int) opt: Optimization level (0, 1 or 2)
- * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
- *                            NULL otherwise
+ *             (PathfindingState *) pf_s: The pathfinding state
  */
-static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
-	SegManager *segMan = s->_segMan;
-	Polygon *polygon;
+static void lookup_visibility_graph(EngineState *s, PathfindingState *pf_s) {
+	PathfindingCache *cache = getPathfindingCache(s);
 	int count = 0;
-	PathfindingState *pf_s = new PathfindingState(width, height);
 
-	// Convert all polygons
-	if (poly_list.segment) {
-		List *list = s->_segMan->lookupList(poly_list);
-		Node *node = s->_segMan->lookupNode(list->first);
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Vertex *vertex;
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			vertex->graphIndex = count++;
+		}
+	}
 
-		while (node) {
-			// The node value might be null, in which case there's no polygon to parse.
-			// Happens in LB2 floppy - refer to bug #3041232
-			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : NULL;
+	if (!cache->enabled)
+		return;
 
-			if (polygon) {
-				pf_s->polygons.push_back(polygon);
-				count += readSelectorValue(segMan, node->value, SELECTOR(size));
-			}
+	Common::Array<int16> polygonData;
+	store_polygon_data(pf_s->polygons, polygonData);
 
-			node = s->_segMan->lookupNode(node->succ);
+	PathfindingCacheEntry *entry = NULL;
+	for (int i = 0; i < PATHFINDING_CACHE_SIZE; i++) {
+		if (cache->entries[i].polygonData == polygonData) {
+			entry = &cache->entries[i];
+			break;
+		}
+	}
+
+	if (entry) {
+		cache->hits++;
+	} else {
+		cache->misses++;
+
+		entry = &cache->entries[0];
+		for (int i = 1; i < PATHFINDING_CACHE_SIZE; i++) {
+			if (cache->entries[i].lastUse < entry->lastUse)
+				entry = &cache->entries[i];
 		}
+
+		entry->polygonData = polygonData;
+		entry->vertices = count;
+		entry->visibility.clear();
+		entry->visibility.resize(count * count);
+		for (int i = 0; i < count * count; i++)
+			entry->visibility[i] = VIS_UNKNOWN;
 	}
 
+	entry->lastUse = ++cache->useCounter;
+	pf_s->_visibility = entry;
+}
+
+/**
+ * Prepares the converted polygons for pathfinding
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) pf_s: The pathfinding state, containing the polygons
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ * Returns   : (PathfindingState *) pf_s on success, NULL otherwise
+ */
+static PathfindingState *prepare_polygon_set(EngineState *s, PathfindingState *pf_s, Common::Point start, Common::Point end, int opt) {
+	Polygon *polygon;
+	int count = 0;
+
 	if (opt == 0)
 		change_polygons_opt_0(pf_s);
 
@@ -1254,6 +1375,9 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// The polygon set is final now, except for the start and end points
+	lookup_visibility_graph(s, pf_s);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1262,7 +1386,10 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	delete new_end;
 
 	// Allocate and build vertex index
-	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it)
+		count += (*it)->vertices.size();
+
+	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * count);
 
 	count = 0;
 
@@ -1280,6 +1407,57 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	return pf_s;
 }
 
+/**
+ * Converts the SCI input data for pathfinding
+ * Parameters: (EngineState *) s: The game state
+ *             (reg_t) poly_list: Polygon list
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
+ *                            NULL otherwise
+ */
+static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
+	Polygon *polygon;
+	PathfindingState *pf_s = new PathfindingState(width, height);
+
+	// Convert all polygons
+	if (poly_list.segment) {
+		List *list = s->_segMan->lookupList(poly_list);
+		Node *node = s->_segMan->lookupNode(list->first);
+
+		while (node) {
+			// The node value might be null, in which case there's no polygon to parse.
+			// Happens in LB2 floppy - refer to bug #3041232
+			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : NULL;
+
+			if (polygon)
+				pf_s->polygons.push_back(polygon);
+
+			node = s->_segMan->lookupNode(node->succ);
+		}
+	}
+
+	PathfindingCache *cache = getPathfindingCache(s);
+	if (cache->recording) {
+		AvoidPathQuery query;
+		store_polygon_data(pf_s->polygons, query.polygonData);
+		query.start = start;
+		query.end = end;
+		query.width = width;
+		query.height = height;
+		query.opt = opt;
+		cache->queries.push_back(query);
+
+		if (cache->queries.size() >= PATHFINDING_MAX_RECORDED_QUERIES) {
+			warning("AvoidPath: Recorded %d calls, stopping the recording", PATHFINDING_MAX_RECORDED_QUERIES);
+			cache->recording = false;
+		}
+	}
+
+	return prepare_polygon_set(s, pf_s, start, end, opt);
+}
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1532,7 +1710,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			return output;
 		}
 
-		// Apply Dijkstra
+		// Apply A*
 		AStar(p);
 
 		output = output_path(p, s);
@@ -1548,6 +1726,29 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	}
 }
 
+int replayAvoidPathQueries(EngineState *s, int repetitions) {
+	const PathfindingCache *cache = getPathfindingCache(s);
+	int unreachable = 0;
+
+	for (int r = 0; r < repetitions; r++) {
+		for (uint q = 0; q < cache->queries.size(); q++) {
+			const AvoidPathQuery &query = cache->queries[q];
+			PathfindingState *p = new PathfindingState(query.width, query.height);
+			load_polygon_data(query.polygonData, p->polygons);
+			p = prepare_polygon_set(s, p, query.start, query.end, query.opt);
+			if (!p)
+				continue;
+
+			AStar(p);
+			if (r == 0 && !p->vertex_end->path_prev)
+				unreachable++;
+			delete p;
+		}
+	}
+
+	return unreachable;
+}
+
 static bool PointInRect(const Common::Point &point, int16 rectX1, int16 rectY1, int16 rectX2, int16 rectY2) {
 	int16 top = MIN<int16>(rectY1, rectY2);
 	int16 left = MIN<int16>(rectX1, rectX2);
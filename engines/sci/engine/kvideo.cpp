@@ -39,6 +39,7 @@
 #include "video/qt_decoder.h"
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
+#include "sci/graphics/frameout.h"
 #include "video/coktel_decoder.h"
 #include "sci/video/robot_decoder.h"
 #endif
@@ -121,6 +122,12 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 
 	delete[] scaleBuffer;
 	delete videoDecoder;
+
+#ifdef ENABLE_SCI32
+	// The video was drawn directly to the screen, kFrameout has to restore it
+	if (g_sci->_gfxFrameout)
+		g_sci->_gfxFrameout->forceFullRedraw();
+#endif
 }
 
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
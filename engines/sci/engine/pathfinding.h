@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCI_ENGINE_PATHFINDING_H
+#define SCI_ENGINE_PATHFINDING_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Sci {
+
+struct EngineState;
+
+#define PATHFINDING_CACHE_SIZE 4
+
+// Maximum number of kAvoidPath calls kept by avoidpath_record
+#define PATHFINDING_MAX_RECORDED_QUERIES 4096
+
+// Cached visibility graph of a polygon set
+struct PathfindingCacheEntry {
+	// Type, vertex count and vertices of every polygon, in vertex index order
+	Common::Array<int16> polygonData;
+
+	// Visibility of every pair of polygon vertices, filled in when needed
+	Common::Array<byte> visibility;
+	int vertices;
+
+	uint32 lastUse;
+
+	PathfindingCacheEntry() : vertices(0), lastUse(0) {}
+};
+
+// A recorded kAvoidPath call, for benchmarking
+struct AvoidPathQuery {
+	Common::Array<int16> polygonData;
+	Common::Point start, end;
+	int width, height, opt;
+};
+
+/**
+ * Scripts call kAvoidPath with the same polygons for every movement of an
+ * actor. The visibility tests between the polygon vertices are by far the
+ * most expensive part of pathfinding, so their results are kept for the most
+ * recently used polygon sets.
+ */
+struct PathfindingCache {
+	PathfindingCacheEntry entries[PATHFINDING_CACHE_SIZE];
+	uint32 useCounter;
+	bool enabled;
+
+	uint32 hits;
+	uint32 misses;
+
+	bool recording;
+	Common::Array<AvoidPathQuery> queries;
+
+	PathfindingCache() : useCounter(0), enabled(true), hits(0), misses(0), recording(false) {}
+};
+
+/**
+ * Returns the pathfinding cache of the game state, creating it if needed.
+ */
+PathfindingCache *getPathfindingCache(EngineState *s);
+
+/**
+ * Runs the kAvoidPath calls recorded in the pathfinding cache again,
+ * using the cache if it is enabled.
+ * @param s				the game state
+ * @param repetitions	the number of times to run every call
+ * @return the number of recorded calls without a path to their end point
+ */
+int replayAvoidPathQueries(EngineState *s, int repetitions);
+
+} // End of namespace Sci
+
+#endif // SCI_ENGINE_PATHFINDING_H
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/memstream.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/func.h"
@@ -119,6 +120,53 @@ void syncWithSerializer(Common::Serializer &s, reg_t &obj) {
 	s.syncAsUint16LE(obj.offset);
 }
 
+/**
+ * Sync a block of reg_t values. This produces the same data as syncing each
+ * value with syncWithSerializer(), but packs the values into a buffer first,
+ * so that the underlying stream only sees a few large reads/writes instead of
+ * two tiny ones per value.
+ */
+static void syncRegBlock(Common::Serializer &s, reg_t *regs, uint32 count) {
+	enum { kChunkSize = 512 };
+	byte buf[kChunkSize * 4];
+
+	while (count) {
+		uint32 chunk = MIN<uint32>(count, kChunkSize);
+
+		if (s.isSaving()) {
+			for (uint32 i = 0; i < chunk; i++) {
+				WRITE_LE_UINT16(buf + i * 4, regs[i].segment);
+				WRITE_LE_UINT16(buf + i * 4 + 2, regs[i].offset);
+			}
+		}
+
+		s.syncBytes(buf, chunk * 4);
+
+		if (s.isLoading()) {
+			for (uint32 i = 0; i < chunk; i++) {
+				regs[i].segment = READ_LE_UINT16(buf + i * 4);
+				regs[i].offset = READ_LE_UINT16(buf + i * 4 + 2);
+			}
+		}
+
+		regs += chunk;
+		count -= chunk;
+	}
+}
+
+// reg_t arrays (locals, object variables) are synced in bulk
+template<>
+void syncArray(Common::Serializer &s, Common::Array<reg_t> &arr) {
+	uint len = arr.size();
+	s.syncAsUint32LE(len);
+
+	if (s.isLoading())
+		arr.resize(len);
+
+	if (len)
+		syncRegBlock(s, &arr[0], len);
+}
+
 template<>
 void syncWithSerializer(Common::Serializer &s, synonym_t &obj) {
 	s.syncAsUint16LE(obj.replaceant);
@@ -375,17 +423,7 @@ void syncWithSerializer(Common::Serializer &s, SegmentObjTable<SciArray<reg_t> >
 		obj.setSize(size);
 	}
 
-	for (uint32 i = 0; i < size; i++) {
-		reg_t value;
-
-		if (s.isSaving())
-			value = obj.getValue(i);
-
-		syncWithSerializer(s, value);
-
-		if (s.isLoading())
-			obj.setValue(i, value);
-	}
+	syncRegBlock(s, obj.getRawData(), size);
 }
 
 template<>
@@ -402,17 +440,8 @@ void syncWithSerializer(Common::Serializer &s, SegmentObjTable<SciString>::Entry
 		obj.setSize(size);
 	}
 
-	for (uint32 i = 0; i < size; i++) {
-		char value = 0;
-
-		if (s.isSaving())
-			value = obj.getValue(i);
-
-		s.syncAsByte(value);
-
-		if (s.isLoading())
-			obj.setValue(i, value);
-	}
+	if (size)
+		s.syncBytes((byte *)obj.getRawData(), size);
 }
 #endif
 
@@ -825,9 +854,15 @@ bool gamestate_save(EngineState *s, Common::WriteStream *fh, const Common::Strin
 		return false;
 	}
 
-	Common::Serializer ser(0, fh);
+	uint32 startTime = g_system->getMillis();
+
+	// Serialize into memory first. The save file is usually a compressing
+	// stream, and handing it lots of tiny writes is much slower than
+	// compressing the whole state in one go.
+	Common::MemoryWriteStreamDynamic buffer(DisposeAfterUse::YES);
+	Common::Serializer ser(0, &buffer);
 	sync_SavegameMetadata(ser, meta);
-	Graphics::saveThumbnail(*fh);
+	Graphics::saveThumbnail(buffer);
 	s->saveLoadWithSerializer(ser);		// FIXME: Error handling?
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->saveLoadWithSerializer(ser);
@@ -835,6 +870,13 @@ bool gamestate_save(EngineState *s, Common::WriteStream *fh, const Common::Strin
 	if (voc)
 		voc->saveLoadWithSerializer(ser);
 
+	uint32 serializeTime = g_system->getMillis() - startTime;
+
+	fh->write(buffer.getData(), buffer.size());
+
+	debugC(kDebugLevelFile, "Saved %d bytes of game state, %d ms serializing, %d ms writing",
+			buffer.size(), serializeTime, g_system->getMillis() - startTime - serializeTime);
+
 	return true;
 }
 
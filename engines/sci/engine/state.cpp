@@ -32,6 +32,7 @@
 #include "sci/engine/vm.h"
 #include "sci/engine/script.h"
 #include "sci/engine/message.h"
+#include "sci/engine/pathfinding.h"
 
 namespace Sci {
 
@@ -68,13 +69,14 @@ static const uint16 s_halfWidthSJISMap[256] = {
 };
 
 EngineState::EngineState(SegManager *segMan)
-: _segMan(segMan), _dirseeker() {
+: _segMan(segMan), _dirseeker(), _pathfindingCache(0) {
 
 	reset(false);
 }
 
 EngineState::~EngineState() {
 	delete _msgState;
+	delete _pathfindingCache;
 }
 
 void EngineState::reset(bool isRestoring) {
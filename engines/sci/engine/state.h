@@ -45,6 +45,7 @@ namespace Sci {
 class EventManager;
 class MessageState;
 class SoundCommandParser;
+struct PathfindingCache;
 
 enum AbortGameState {
 	kAbortNone = 0,
@@ -230,6 +231,8 @@ public:
 	VideoState _videoState;
 	bool _syncedAudioOptions;
 
+	PathfindingCache *_pathfindingCache; /**< Visibility graphs of recent kAvoidPath calls */
+
 	/**
 	 * Resets the engine state.
 	 */
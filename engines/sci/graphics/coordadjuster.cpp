@@ -125,11 +125,23 @@ void GfxCoordAdjuster32::fromScriptToDisplay(int16 &y, int16 &x) {
 
 void GfxCoordAdjuster32::pictureSetDisplayArea(Common::Rect displayArea) {
 	_pictureDisplayArea = displayArea;
+	_pictureClipArea = displayArea;
 }
 
 Common::Rect GfxCoordAdjuster32::pictureGetDisplayArea() {
 	return _pictureDisplayArea;
 }
+
+// Restricts picture drawing to a part of the display area, used by kFrameout
+//  to redraw only the areas of the screen that changed
+void GfxCoordAdjuster32::pictureSetClipArea(Common::Rect clipArea) {
+	_pictureClipArea = clipArea;
+	_pictureClipArea.clip(_pictureDisplayArea);
+}
+
+Common::Rect GfxCoordAdjuster32::pictureGetClipArea() {
+	return _pictureClipArea;
+}
 #endif
 
 } // End of namespace Sci
@@ -52,6 +52,7 @@ public:
 	virtual void fromDisplayToScript(int16 &y, int16 &x) { }
 
 	virtual Common::Rect pictureGetDisplayArea() { return Common::Rect(0, 0); }
+	virtual Common::Rect pictureGetClipArea() { return pictureGetDisplayArea(); }
 private:
 };
 
@@ -90,11 +91,14 @@ public:
 
 	void pictureSetDisplayArea(Common::Rect displayArea);
 	Common::Rect pictureGetDisplayArea();
+	void pictureSetClipArea(Common::Rect clipArea);
+	Common::Rect pictureGetClipArea();
 
 private:
 	SegManager *_segMan;
 
 	Common::Rect _pictureDisplayArea;
+	Common::Rect _pictureClipArea;
 
 	uint16 _scriptsRunningWidth;
 	uint16 _scriptsRunningHeight;
@@ -53,12 +53,24 @@ namespace Sci {
 
 // TODO/FIXME: This is all guesswork
 
+enum {
+	kMaxDirtyRects = 16 // Maximum amount of separate areas redrawn in one frame
+};
+
 GfxFrameout::GfxFrameout(SegManager *segMan, ResourceManager *resMan, GfxCoordAdjuster *coordAdjuster, GfxCache *cache, GfxScreen *screen, GfxPalette *palette, GfxPaint32 *paint32)
 	: _segMan(segMan), _resMan(resMan), _cache(cache), _screen(screen), _palette(palette), _paint32(paint32) {
 
 	_coordAdjuster = (GfxCoordAdjuster32 *)coordAdjuster;
 	_scriptsRunningWidth = 320;
 	_scriptsRunningHeight = 200;
+
+	_fullRedraw = true;
+	_showRedrawRects = false;
+	_statFrames = 0;
+	_statSkippedFrames = 0;
+	_statLastRectCount = 0;
+	_statLastPixels = 0;
+	_statTotalPixels = 0;
 }
 
 GfxFrameout::~GfxFrameout() {
@@ -69,6 +81,8 @@ void GfxFrameout::clear() {
 	deletePlaneItems(NULL_REG);
 	_planes.clear();
 	deletePlanePictures(NULL_REG);
+	_dirtyRects.clear();
+	_fullRedraw = true;
 }
 
 void GfxFrameout::kernelAddPlane(reg_t object) {
@@ -97,6 +111,7 @@ void GfxFrameout::kernelAddPlane(reg_t object) {
 	newPlane.pictureId = 0xFFFF;
 	newPlane.planePictureMirrored = false;
 	newPlane.planeBack = 0;
+	newPlane.needsRedraw = true;
 	_planes.push_back(newPlane);
 
 	kernelUpdatePlane(object);
@@ -199,6 +214,7 @@ void GfxFrameout::kernelDeletePlane(reg_t object) {
 			planeRect.right = (planeRect.right * screenRect.width()) / _scriptsRunningWidth;
 			// Blackout removed plane rect
 			_paint32->fillRect(planeRect, 0);
+			addDirtyRect(planeRect);
 			return;
 		}
 	}
@@ -282,6 +298,9 @@ void GfxFrameout::kernelDeleteScreenItem(reg_t object) {
 		return;
 	}
 
+	if (itemEntry->lastDrawn)
+		addDirtyRect(itemEntry->lastScreenRect);
+
 	_screenItems.remove(itemEntry);
 	delete itemEntry;
 }
@@ -300,6 +319,8 @@ void GfxFrameout::deletePlaneItems(reg_t planeObject) {
 		
 		if (objectMatches) {
 			FrameoutEntry *itemEntry = *listIterator;
+			if (itemEntry->lastDrawn)
+				addDirtyRect(itemEntry->lastScreenRect);
 			listIterator = _screenItems.erase(listIterator);
 			delete itemEntry;
 		} else {
@@ -325,6 +346,11 @@ int16 GfxFrameout::kernelGetHighPlanePri() {
 
 void GfxFrameout::kernelAddPicAt(reg_t planeObj, GuiResourceId pictureId, int16 pictureX, int16 pictureY) {
 	addPlanePicture(planeObj, pictureId, pictureX, pictureY);
+
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); ++it) {
+		if (it->object == planeObj)
+			it->needsRedraw = true;
+	}
 }
 
 bool sortHelper(const FrameoutEntry* entry1, const FrameoutEntry* entry2) {
@@ -505,179 +531,426 @@ void GfxFrameout::drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int1
 	//	warning("picture cel %d %d", itemEntry->celNo, itemEntry->priority);
 }
 
-void GfxFrameout::kernelFrameout() {
-	if (g_sci->_robotDecoder->isVideoLoaded()) {
-		showVideo();
+void GfxFrameout::addDirtyRect(Common::Rect rect) {
+	rect.clip(_screen->getWidth(), _screen->getHeight());
+	if (rect.isEmpty())
 		return;
+
+	// Merge the new rect with all dirty rects it overlaps, so that the list
+	// never contains overlapping rects and nothing gets drawn twice
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		if (_dirtyRects[i].contains(rect))
+			return;
+		if (_dirtyRects[i].intersects(rect)) {
+			rect.extend(_dirtyRects[i]);
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
 	}
 
-	_palette->palVaryUpdate();
+	// Too many rects cost more in overhead than they save in drawing
+	if (_dirtyRects.size() >= kMaxDirtyRects) {
+		for (i = 0; i < _dirtyRects.size(); i++)
+			rect.extend(_dirtyRects[i]);
+		_dirtyRects.clear();
+	}
+
+	_dirtyRects.push_back(rect);
+}
+
+Common::Rect GfxFrameout::displayToScreenRect(Common::Rect rect) {
+	if (!_screen->getUpscaledHires())
+		return rect;
+
+	_screen->adjustBackUpscaledCoordinates(rect.top, rect.left);
+	_screen->adjustBackUpscaledCoordinates(rect.bottom, rect.right);
+	// Round up, so that the whole display area is covered
+	rect.right++;
+	rect.bottom++;
+	rect.clip(_screen->getWidth(), _screen->getHeight());
+	return rect;
+}
+
+Common::Rect GfxFrameout::screenToDisplayRect(Common::Rect rect) {
+	if (!_screen->getUpscaledHires())
+		return rect;
+
+	rect.clip(_screen->getWidth(), _screen->getHeight());
+	_screen->adjustToUpscaledCoordinates(rect.top, rect.left);
+	_screen->adjustToUpscaledCoordinates(rect.bottom, rect.right);
+	return rect;
+}
+
+void GfxFrameout::invalidateScreenItem(reg_t object) {
+	FrameoutEntry *itemEntry = findScreenItem(object);
+	if (itemEntry)
+		itemEntry->needsRedraw = true;
+}
+
+bool GfxFrameout::layoutScreenItem(PlaneEntry &plane, FrameoutEntry *itemEntry) {
+	if (!itemEntry->visible)
+		return false;
+
+	if (itemEntry->object.isNull()) {
+		// Picture cel data
+		itemEntry->x = upscaleHorizontalCoordinate(itemEntry->x);
+		itemEntry->y = upscaleVerticalCoordinate(itemEntry->y);
+		itemEntry->picStartX = upscaleHorizontalCoordinate(itemEntry->picStartX);
+		itemEntry->picStartY = upscaleVerticalCoordinate(itemEntry->picStartY);
+
+		// Picture cels only change together with their plane
+		itemEntry->screenRect = plane.planeRect;
+		return !isPictureOutOfView(itemEntry, plane.planeRect, plane.planeOffsetX, plane.planeOffsetY);
+	}
+
+	GfxView *view = (itemEntry->viewId != 0xFFFF) ? _cache->getView(itemEntry->viewId) : NULL;
+
+	if (view && view->isSci2Hires()) {
+		int16 dummyX = 0;
+		view->adjustToUpscaledCoordinates(itemEntry->y, itemEntry->x);
+		view->adjustToUpscaledCoordinates(itemEntry->z, dummyX);
+	} else if (getSciVersion() == SCI_VERSION_2_1) {
+		itemEntry->x = upscaleHorizontalCoordinate(itemEntry->x);
+		itemEntry->y = upscaleVerticalCoordinate(itemEntry->y);
+		itemEntry->z = upscaleVerticalCoordinate(itemEntry->z);
+	}
+
+	// Adjust according to current scroll position
+	itemEntry->x -= plane.planeOffsetX;
+	itemEntry->y -= plane.planeOffsetY;
+
+	uint16 useInsetRect = readSelectorValue(_segMan, itemEntry->object, SELECTOR(useInsetRect));
+	if (useInsetRect) {
+		itemEntry->celRect.top = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inTop));
+		itemEntry->celRect.left = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inLeft));
+		itemEntry->celRect.bottom = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inBottom));
+		itemEntry->celRect.right = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inRight));
+		if (view && view->isSci2Hires()) {
+			view->adjustToUpscaledCoordinates(itemEntry->celRect.top, itemEntry->celRect.left);
+			view->adjustToUpscaledCoordinates(itemEntry->celRect.bottom, itemEntry->celRect.right);
+		}
+		itemEntry->celRect.translate(itemEntry->x, itemEntry->y);
+		// TODO: maybe we should clip the cels rect with this, i'm not sure
+		//  the only currently known usage is game menu of gk1
+	} else if (view) {
+			if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
+				view->getCelRect(itemEntry->loopNo, itemEntry->celNo,
+					itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->celRect);
+			else
+				view->getCelScaledRect(itemEntry->loopNo, itemEntry->celNo,
+					itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->scaleX,
+					itemEntry->scaleY, itemEntry->celRect);
+
+		Common::Rect nsRect = itemEntry->celRect;
+		// Translate back to actual coordinate within scrollable plane
+		nsRect.translate(plane.planeOffsetX, plane.planeOffsetY);
+
+		if (view && view->isSci2Hires()) {
+			view->adjustBackUpscaledCoordinates(nsRect.top, nsRect.left);
+			view->adjustBackUpscaledCoordinates(nsRect.bottom, nsRect.right);
+		} else if (getSciVersion() == SCI_VERSION_2_1) {
+			nsRect = upscaleRect(nsRect);
+		}
+
+		if (g_sci->getGameId() == GID_PHANTASMAGORIA2) {
+			// HACK: Some (?) objects in Phantasmagoria 2 have no NS rect. Skip them for now.
+			// TODO: Remove once we figure out how Phantasmagoria 2 draws objects on screen.
+			if (lookupSelector(_segMan, itemEntry->object, SELECTOR(nsLeft), NULL, NULL) != kSelectorVariable)
+				return false;
+		}
+
+		g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
+	}
+
+	int16 screenHeight = _screen->getHeight();
+	int16 screenWidth = _screen->getWidth();
+	if (view && view->isSci2Hires()) {
+		screenHeight = _screen->getDisplayHeight();
+		screenWidth = _screen->getDisplayWidth();
+	}
+
+	if (itemEntry->celRect.bottom < 0 || itemEntry->celRect.top >= screenHeight)
+		return false;
+
+	if (itemEntry->celRect.right < 0 || itemEntry->celRect.left >= screenWidth)
+		return false;
+
+	itemEntry->clipRect = itemEntry->celRect;
+
+	Common::Rect translatedClipRect;
+	if (view && view->isSci2Hires()) {
+		itemEntry->clipRect.clip(plane.upscaledPlaneClipRect);
+		translatedClipRect = itemEntry->clipRect;
+		translatedClipRect.translate(plane.upscaledPlaneRect.left, plane.upscaledPlaneRect.top);
+		translatedClipRect = displayToScreenRect(translatedClipRect);
+	} else {
+		itemEntry->clipRect.clip(plane.planeClipRect);
+		translatedClipRect = itemEntry->clipRect;
+		translatedClipRect.translate(plane.planeRect.left, plane.planeRect.top);
+	}
+
+	itemEntry->screenRect = Common::Rect();
+	if (view && !itemEntry->clipRect.isEmpty())
+		itemEntry->screenRect = translatedClipRect;
+
+	itemEntry->hasText = (lookupSelector(_segMan, itemEntry->object, SELECTOR(text), NULL, NULL) == kSelectorVariable);
+	if (itemEntry->hasText) {
+		Common::Rect textRect = g_sci->_gfxText32->getTextBitmapRect(itemEntry->x, itemEntry->y, plane.planeRect, itemEntry->object);
+		if (itemEntry->screenRect.isEmpty())
+			itemEntry->screenRect = textRect;
+		else if (!textRect.isEmpty())
+			itemEntry->screenRect.extend(textRect);
+	}
+
+	itemEntry->screenRect.clip(_screen->getWidth(), _screen->getHeight());
+	return !itemEntry->screenRect.isEmpty();
+}
+
+void GfxFrameout::layoutPlane(PlaneEntry &plane) {
+	reg_t planeObject = plane.object;
+	uint16 planeLastPriority = plane.lastPriority;
+
+	// Update priority here, sq6 sets it w/o UpdatePlane
+	uint16 planePriority = plane.priority = readSelectorValue(_segMan, planeObject, SELECTOR(priority));
+	plane.lastPriority = planePriority;
+
+	// Any change of the plane itself requires redrawing everything inside it
+	if (plane.needsRedraw || planePriority != planeLastPriority ||
+		plane.planeRect != plane.lastPlaneRect ||
+		plane.planeOffsetX != plane.lastPlaneOffsetX || plane.planeOffsetY != plane.lastPlaneOffsetY ||
+		plane.pictureId != plane.lastPictureId || plane.planePictureMirrored != plane.lastPlanePictureMirrored ||
+		plane.planeBack != plane.lastPlaneBack) {
+		if (planeLastPriority != 0xffff)
+			addDirtyRect(plane.lastPlaneRect);
+		addDirtyRect(plane.planeRect);
+	}
+
+	plane.lastPlaneRect = plane.planeRect;
+	plane.lastPlaneOffsetX = plane.planeOffsetX;
+	plane.lastPlaneOffsetY = plane.planeOffsetY;
+	plane.lastPictureId = plane.pictureId;
+	plane.lastPlanePictureMirrored = plane.planePictureMirrored;
+	plane.lastPlaneBack = plane.planeBack;
+	plane.needsRedraw = false;
+
+	if (planePriority == 0xffff) { // Plane currently not meant to be shown
+		// If plane was shown before, delete plane rect
+		if (planePriority != planeLastPriority)
+			_paint32->fillRect(plane.planeRect, 0);
+		return;
+	}
+
+	_palette->drewPicture(plane.pictureId);
+
+	createPlaneItemList(planeObject, plane.itemList);
 
-	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
-		reg_t planeObject = it->object;
-		uint16 planeLastPriority = it->lastPriority;
+	for (FrameoutList::iterator listIterator = plane.itemList.begin(); listIterator != plane.itemList.end(); listIterator++) {
+		FrameoutEntry *itemEntry = *listIterator;
 
-		// Update priority here, sq6 sets it w/o UpdatePlane
-		uint16 planePriority = it->priority = readSelectorValue(_segMan, planeObject, SELECTOR(priority));
+		itemEntry->drawn = layoutScreenItem(plane, itemEntry);
 
-		it->lastPriority = planePriority;
-		if (planePriority == 0xffff) { // Plane currently not meant to be shown
-			// If plane was shown before, delete plane rect
-			if (planePriority != planeLastPriority)
-				_paint32->fillRect(it->planeRect, 0);
+		// Picture cels are recreated each frame, they are covered by the plane
+		if (itemEntry->object.isNull())
 			continue;
+
+		if (itemEntry->needsRedraw || itemEntry->drawn != itemEntry->lastDrawn ||
+			(itemEntry->drawn && (itemEntry->screenRect != itemEntry->lastScreenRect ||
+			itemEntry->viewId != itemEntry->lastViewId || itemEntry->loopNo != itemEntry->lastLoopNo ||
+			itemEntry->celNo != itemEntry->lastCelNo || itemEntry->priority != itemEntry->lastPriority ||
+			itemEntry->scaleX != itemEntry->lastScaleX || itemEntry->scaleY != itemEntry->lastScaleY))) {
+			if (itemEntry->lastDrawn)
+				addDirtyRect(itemEntry->lastScreenRect);
+			if (itemEntry->drawn)
+				addDirtyRect(itemEntry->screenRect);
 		}
 
-		// There is a race condition lurking in SQ6, which causes the game to hang in the intro, when teleporting to Polysorbate LX.
-		// Since I first wrote the patch, the race has stopped occurring for me though.
-		// I'll leave this for investigation later, when someone can reproduce.
-		//if (it->pictureId == 0xffff)	// FIXME: This is what SSCI does, and fixes the intro of LSL7, but breaks the dialogs in GK1 (adds black boxes)
-		if (it->planeBack)
-			_paint32->fillRect(it->planeRect, it->planeBack);
+		itemEntry->lastViewId = itemEntry->viewId;
+		itemEntry->lastLoopNo = itemEntry->loopNo;
+		itemEntry->lastCelNo = itemEntry->celNo;
+		itemEntry->lastPriority = itemEntry->priority;
+		itemEntry->lastScaleX = itemEntry->scaleX;
+		itemEntry->lastScaleY = itemEntry->scaleY;
+		itemEntry->lastScreenRect = itemEntry->screenRect;
+		itemEntry->lastDrawn = itemEntry->drawn;
+		itemEntry->needsRedraw = false;
+	}
+}
 
-		GuiResourceId planeMainPictureId = it->pictureId;
+void GfxFrameout::drawScreenItem(PlaneEntry &plane, FrameoutEntry *itemEntry, const Common::Rect &dirtyRect) {
+	if (itemEntry->object.isNull()) {
+		drawPicture(itemEntry, plane.planeOffsetX, plane.planeOffsetY, plane.planePictureMirrored);
+		return;
+	}
 
-		_coordAdjuster->pictureSetDisplayArea(it->planeRect);
-		_palette->drewPicture(planeMainPictureId);
+	GfxView *view = (itemEntry->viewId != 0xFFFF) ? _cache->getView(itemEntry->viewId) : NULL;
 
-		FrameoutList itemList;
+	if (view && !itemEntry->clipRect.isEmpty()) {
+		// Only draw the part of the cel that is inside the dirty area
+		Common::Rect clipRect = itemEntry->clipRect;
+		Common::Rect planeRect = plane.planeRect;
+		Common::Rect planeDirtyRect = dirtyRect;
+		if (view->isSci2Hires()) {
+			planeRect = plane.upscaledPlaneRect;
+			planeDirtyRect = screenToDisplayRect(planeDirtyRect);
+		}
+		planeDirtyRect.translate(-planeRect.left, -planeRect.top);
+		clipRect.clip(planeDirtyRect);
+
+		if (!clipRect.isEmpty()) {
+			Common::Rect translatedClipRect = clipRect;
+			translatedClipRect.translate(planeRect.left, planeRect.top);
+
+			if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
+				view->draw(itemEntry->celRect, clipRect, translatedClipRect,
+					itemEntry->loopNo, itemEntry->celNo, 255, 0, view->isSci2Hires());
+			else
+				view->drawScaled(itemEntry->celRect, clipRect, translatedClipRect,
+					itemEntry->loopNo, itemEntry->celNo, 255, itemEntry->scaleX, itemEntry->scaleY);
+		}
+	}
 
-		createPlaneItemList(planeObject, itemList);
+	// Draw text, if it exists. Text bitmaps are always drawn completely, kFrameout
+	// makes sure that their whole area is part of the dirty area
+	if (itemEntry->hasText)
+		g_sci->_gfxText32->drawTextBitmap(itemEntry->x, itemEntry->y, plane.planeRect, itemEntry->object);
+}
 
-//		warning("Plane %s", _segMan->getObjectName(planeObject));
+void GfxFrameout::drawPlane(PlaneEntry &plane, const Common::Rect &dirtyRect) {
+	Common::Rect planeDirtyRect = plane.planeRect;
+	planeDirtyRect.clip(dirtyRect);
+	if (planeDirtyRect.isEmpty())
+		return;
 
-		for (FrameoutList::iterator listIterator = itemList.begin(); listIterator != itemList.end(); listIterator++) {
-			FrameoutEntry *itemEntry = *listIterator;
+	// There is a race condition lurking in SQ6, which causes the game to hang in the intro, when teleporting to Polysorbate LX.
+	// Since I first wrote the patch, the race has stopped occurring for me though.
+	// I'll leave this for investigation later, when someone can reproduce.
+	//if (it->pictureId == 0xffff)	// FIXME: This is what SSCI does, and fixes the intro of LSL7, but breaks the dialogs in GK1 (adds black boxes)
+	if (plane.planeBack)
+		_paint32->fillRect(planeDirtyRect, plane.planeBack);
 
-			if (!itemEntry->visible)
-				continue;
-			
-			if (itemEntry->object.isNull()) {
-				// Picture cel data
-				itemEntry->x = upscaleHorizontalCoordinate(itemEntry->x);
-				itemEntry->y = upscaleVerticalCoordinate(itemEntry->y);
-				itemEntry->picStartX = upscaleHorizontalCoordinate(itemEntry->picStartX);
-				itemEntry->picStartY = upscaleVerticalCoordinate(itemEntry->picStartY);
-
-				if (!isPictureOutOfView(itemEntry, it->planeRect, it->planeOffsetX, it->planeOffsetY))
-					drawPicture(itemEntry, it->planeOffsetX, it->planeOffsetY, it->planePictureMirrored);
-			} else {
-				GfxView *view = (itemEntry->viewId != 0xFFFF) ? _cache->getView(itemEntry->viewId) : NULL;
-				
-				if (view && view->isSci2Hires()) {
-					int16 dummyX = 0;
-					view->adjustToUpscaledCoordinates(itemEntry->y, itemEntry->x);
-					view->adjustToUpscaledCoordinates(itemEntry->z, dummyX);
-				} else if (getSciVersion() == SCI_VERSION_2_1) {
-					itemEntry->x = upscaleHorizontalCoordinate(itemEntry->x);
-					itemEntry->y = upscaleVerticalCoordinate(itemEntry->y);
-					itemEntry->z = upscaleVerticalCoordinate(itemEntry->z);
-				}
+	_coordAdjuster->pictureSetDisplayArea(plane.planeRect);
+	_coordAdjuster->pictureSetClipArea(planeDirtyRect);
 
-				// Adjust according to current scroll position
-				itemEntry->x -= it->planeOffsetX;
-				itemEntry->y -= it->planeOffsetY;
-
-				uint16 useInsetRect = readSelectorValue(_segMan, itemEntry->object, SELECTOR(useInsetRect));
-				if (useInsetRect) {
-					itemEntry->celRect.top = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inTop));
-					itemEntry->celRect.left = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inLeft));
-					itemEntry->celRect.bottom = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inBottom));
-					itemEntry->celRect.right = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inRight));
-					if (view && view->isSci2Hires()) {
-						view->adjustToUpscaledCoordinates(itemEntry->celRect.top, itemEntry->celRect.left);
-						view->adjustToUpscaledCoordinates(itemEntry->celRect.bottom, itemEntry->celRect.right);
-					}
-					itemEntry->celRect.translate(itemEntry->x, itemEntry->y);
-					// TODO: maybe we should clip the cels rect with this, i'm not sure
-					//  the only currently known usage is game menu of gk1
-				} else if (view) {
-						if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
-							view->getCelRect(itemEntry->loopNo, itemEntry->celNo,
-								itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->celRect);
-						else
-							view->getCelScaledRect(itemEntry->loopNo, itemEntry->celNo, 
-								itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->scaleX,
-								itemEntry->scaleY, itemEntry->celRect);
-
-					Common::Rect nsRect = itemEntry->celRect;
-					// Translate back to actual coordinate within scrollable plane
-					nsRect.translate(it->planeOffsetX, it->planeOffsetY);
-
-					if (view && view->isSci2Hires()) {
-						view->adjustBackUpscaledCoordinates(nsRect.top, nsRect.left);
-						view->adjustBackUpscaledCoordinates(nsRect.bottom, nsRect.right);
-					} else if (getSciVersion() == SCI_VERSION_2_1) {
-						nsRect = upscaleRect(nsRect);
-					}
+//	warning("Plane %s", _segMan->getObjectName(plane.object));
 
-					if (g_sci->getGameId() == GID_PHANTASMAGORIA2) {
-						// HACK: Some (?) objects in Phantasmagoria 2 have no NS rect. Skip them for now.
-						// TODO: Remove once we figure out how Phantasmagoria 2 draws objects on screen.
-						if (lookupSelector(_segMan, itemEntry->object, SELECTOR(nsLeft), NULL, NULL) != kSelectorVariable)
-							continue;
-					}
+	for (FrameoutList::iterator listIterator = plane.itemList.begin(); listIterator != plane.itemList.end(); listIterator++) {
+		FrameoutEntry *itemEntry = *listIterator;
 
-					g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
-				}
+		if (itemEntry->drawn && itemEntry->screenRect.intersects(dirtyRect))
+			drawScreenItem(plane, itemEntry, dirtyRect);
+	}
+}
 
-				int16 screenHeight = _screen->getHeight();
-				int16 screenWidth = _screen->getWidth();
-				if (view && view->isSci2Hires()) {
-					screenHeight = _screen->getDisplayHeight();
-					screenWidth = _screen->getDisplayWidth();
-				}
+void GfxFrameout::showRedrawRects() {
+	Graphics::Surface *screen = g_system->lockScreen();
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		Common::Rect rect = screenToDisplayRect(_dirtyRects[i]);
+		rect.clip(screen->w, screen->h);
+		if (!rect.isEmpty())
+			screen->frameRect(rect, _screen->getColorWhite());
+	}
+	g_system->unlockScreen();
+}
 
-				if (itemEntry->celRect.bottom < 0 || itemEntry->celRect.top >= screenHeight)
-					continue;
+void GfxFrameout::kernelFrameout() {
+	if (g_sci->_robotDecoder->isVideoLoaded()) {
+		showVideo();
+		// The video was drawn directly to the screen
+		_fullRedraw = true;
+		return;
+	}
 
-				if (itemEntry->celRect.right < 0 || itemEntry->celRect.left >= screenWidth)
-					continue;
+	_palette->palVaryUpdate();
 
-				Common::Rect clipRect, translatedClipRect;
-				clipRect = itemEntry->celRect;
-
-				if (view && view->isSci2Hires()) {
-					clipRect.clip(it->upscaledPlaneClipRect);
-					translatedClipRect = clipRect;
-					translatedClipRect.translate(it->upscaledPlaneRect.left, it->upscaledPlaneRect.top);
-				} else {
-					clipRect.clip(it->planeClipRect);
-					translatedClipRect = clipRect;
-					translatedClipRect.translate(it->planeRect.left, it->planeRect.top);
-				}
+	// Update all planes and screen items and find out which parts of the screen
+	// changed since the last frame. Only those get redrawn.
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++)
+		layoutPlane(*it);
 
-				if (view) {
-					if (!clipRect.isEmpty()) {
-						if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
-							view->draw(itemEntry->celRect, clipRect, translatedClipRect, 
-								itemEntry->loopNo, itemEntry->celNo, 255, 0, view->isSci2Hires());
-						else
-							view->drawScaled(itemEntry->celRect, clipRect, translatedClipRect, 
-								itemEntry->loopNo, itemEntry->celNo, 255, itemEntry->scaleX, itemEntry->scaleY);
-					}
-				}
+	if (_fullRedraw) {
+		_dirtyRects.clear();
+		_dirtyRects.push_back(Common::Rect(_screen->getWidth(), _screen->getHeight()));
+		_fullRedraw = false;
+	}
 
-				// Draw text, if it exists
-				if (lookupSelector(_segMan, itemEntry->object, SELECTOR(text), NULL, NULL) == kSelectorVariable) {
-					g_sci->_gfxText32->drawTextBitmap(itemEntry->x, itemEntry->y, it->planeRect, itemEntry->object);
+	// Text bitmaps can't be drawn partially, so every text that intersects a
+	// dirty area has to be part of it completely
+	bool dirtyAreaGrew = !_dirtyRects.empty();
+	while (dirtyAreaGrew) {
+		dirtyAreaGrew = false;
+		for (PlaneList::iterator it = _planes.begin(); it != _planes.end() && !dirtyAreaGrew; it++) {
+			for (FrameoutList::iterator listIterator = it->itemList.begin(); listIterator != it->itemList.end(); listIterator++) {
+				FrameoutEntry *itemEntry = *listIterator;
+				if (!itemEntry->drawn || !itemEntry->hasText)
+					continue;
+
+				for (uint i = 0; i < _dirtyRects.size(); i++) {
+					if (_dirtyRects[i].intersects(itemEntry->screenRect) && !_dirtyRects[i].contains(itemEntry->screenRect)) {
+						addDirtyRect(itemEntry->screenRect);
+						dirtyAreaGrew = true;
+						break;
+					}
 				}
+				if (dirtyAreaGrew)
+					break;
 			}
 		}
+	}
 
-		for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
-			if (pictureIt->object == planeObject) {
-				delete[] pictureIt->pictureCels;
-				pictureIt->pictureCels = 0;
-			}
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
+			if (it->priority != 0xffff)
+				drawPlane(*it, _dirtyRects[i]);
 		}
 	}
 
-	_screen->copyToScreen();
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++)
+		it->itemList.clear();
+
+	for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
+		delete[] pictureIt->pictureCels;
+		pictureIt->pictureCels = 0;
+	}
+
+	// Restore the areas that were highlighted in the last frame
+	for (uint i = 0; i < _shownRedrawRects.size(); i++)
+		_screen->copyRectToScreen(_shownRedrawRects[i]);
+	_shownRedrawRects.clear();
+
+	uint32 pixelCount = 0;
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		_screen->copyRectToScreen(_dirtyRects[i]);
+		pixelCount += _dirtyRects[i].width() * _dirtyRects[i].height();
+	}
+
+	if (_showRedrawRects) {
+		showRedrawRects();
+		_shownRedrawRects = _dirtyRects;
+	}
+
+	_statFrames++;
+	if (_dirtyRects.empty())
+		_statSkippedFrames++;
+	_statLastRectCount = _dirtyRects.size();
+	_statLastPixels = pixelCount;
+	_statTotalPixels += pixelCount;
+	debugC(kDebugLevelGraphics, "kFrameout: redrew %d pixels in %d rects", pixelCount, _dirtyRects.size());
+
+	_dirtyRects.clear();
 
 	g_sci->getEngineState()->_throttleTrigger = true;
 }
 
+void GfxFrameout::printFrameStats(Console *con) {
+	con->DebugPrintf("Frames: %d, unchanged: %d\n", _statFrames, _statSkippedFrames);
+	con->DebugPrintf("Last frame: %d pixels redrawn in %d rects\n", _statLastPixels, _statLastRectCount);
+	if (_statFrames)
+		con->DebugPrintf("Average: %d pixels redrawn per frame\n", _statTotalPixels / _statFrames);
+}
+
 void GfxFrameout::printPlaneList(Console *con) {
 	for (PlaneList::const_iterator it = _planes.begin(); it != _planes.end(); ++it) {
 		PlaneEntry p = *it;
@@ -23,10 +23,16 @@
 #ifndef SCI_GRAPHICS_FRAMEOUT_H
 #define SCI_GRAPHICS_FRAMEOUT_H
 
+#include "common/array.h"
+#include "common/list.h"
+
 namespace Sci {
 
 class GfxPicture;
 
+struct FrameoutEntry;
+typedef Common::List<FrameoutEntry *> FrameoutList;
+
 struct PlaneEntry {
 	reg_t object;
 	uint16 priority;
@@ -40,6 +46,17 @@ struct PlaneEntry {
 	Common::Rect upscaledPlaneClipRect;
 	bool planePictureMirrored;
 	byte planeBack;
+
+	// State of the plane when it was last drawn, used to detect changes
+	Common::Rect lastPlaneRect;
+	int16 lastPlaneOffsetX;
+	int16 lastPlaneOffsetY;
+	GuiResourceId lastPictureId;
+	bool lastPlanePictureMirrored;
+	byte lastPlaneBack;
+	bool needsRedraw;
+
+	FrameoutList itemList; // items to draw in the current frame
 };
 
 typedef Common::List<PlaneEntry> PlaneList;
@@ -61,9 +78,24 @@ struct FrameoutEntry {
 	int16 picStartX;
 	int16 picStartY;
 	bool visible;
-};
 
-typedef Common::List<FrameoutEntry *> FrameoutList;
+	// Calculated by kFrameout for the current frame
+	Common::Rect clipRect;		// plane relative rect to draw the cel to
+	Common::Rect screenRect;	// screen area touched by this item
+	bool hasText;
+	bool drawn;
+
+	// State of the item when it was last drawn, used to detect changes
+	GuiResourceId lastViewId;
+	int16 lastLoopNo;
+	int16 lastCelNo;
+	int16 lastPriority;
+	int16 lastScaleX;
+	int16 lastScaleY;
+	Common::Rect lastScreenRect;
+	bool lastDrawn;
+	bool needsRedraw;
+};
 
 struct PlanePictureEntry {
 	reg_t object;
@@ -106,6 +138,11 @@ public:
 	void clear();
 	void printPlaneList(Console *con);
 	void printPlaneItemList(Console *con, reg_t planeObject);
+	void printFrameStats(Console *con);
+
+	void invalidateScreenItem(reg_t object);
+	void forceFullRedraw() { _fullRedraw = true; }
+	void setShowRedrawRects(bool show) { _showRedrawRects = show; }
 
 private:
 	void showVideo();
@@ -116,6 +153,15 @@ private:
 	int16 upscaleVerticalCoordinate(int16 coordinate);
 	Common::Rect upscaleRect(Common::Rect &rect);
 
+	void layoutPlane(PlaneEntry &plane);
+	bool layoutScreenItem(PlaneEntry &plane, FrameoutEntry *itemEntry);
+	void drawPlane(PlaneEntry &plane, const Common::Rect &dirtyRect);
+	void drawScreenItem(PlaneEntry &plane, FrameoutEntry *itemEntry, const Common::Rect &dirtyRect);
+	void addDirtyRect(Common::Rect rect);
+	Common::Rect displayToScreenRect(Common::Rect rect);
+	Common::Rect screenToDisplayRect(Common::Rect rect);
+	void showRedrawRects();
+
 	SegManager *_segMan;
 	ResourceManager *_resMan;
 	GfxCoordAdjuster32 *_coordAdjuster;
@@ -132,6 +178,21 @@ private:
 
 	uint16 _scriptsRunningWidth;
 	uint16 _scriptsRunningHeight;
+
+	/**
+	 * Screen areas that have to be redrawn in the next frame, in screen
+	 * coordinates. Overlapping areas are merged when they get added.
+	 */
+	Common::Array<Common::Rect> _dirtyRects;
+	Common::Array<Common::Rect> _shownRedrawRects;
+	bool _fullRedraw;
+	bool _showRedrawRects;
+
+	uint32 _statFrames;
+	uint32 _statSkippedFrames;
+	uint32 _statLastRectCount;
+	uint32 _statLastPixels;
+	uint32 _statTotalPixels;
 };
 
 } // End of namespace Sci
@@ -42,11 +42,9 @@ GfxPaint32::~GfxPaint32() {
 }
 
 void GfxPaint32::fillRect(Common::Rect rect, byte color) {
-	int16 y, x;
+	int16 y;
 	for (y = rect.top; y < rect.bottom; y++) {
-		for (x = rect.left; x < rect.right; x++) {
-			_screen->putPixel(x, y, GFX_SCREEN_MASK_VISUAL, color, 0, 0);
-		}
+		_screen->putPixelSpan(rect.left, y, rect.width(), GFX_SCREEN_MASK_VISUAL, color, 0, 0);
 	}
 }
 
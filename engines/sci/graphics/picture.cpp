@@ -88,11 +88,9 @@ void GfxPicture::draw(int16 animationNr, bool mirroredFlag, bool addToFlag, int1
 }
 
 void GfxPicture::reset() {
-	int16 x, y;
+	int16 y;
 	for (y = _ports->getPort()->top; y < _screen->getHeight(); y++) {
-		for (x = 0; x < _screen->getWidth(); x++) {
-			_screen->putPixel(x, y, GFX_SCREEN_MASK_ALL, 255, 0, 0);
-		}
+		_screen->putPixelSpan(0, y, _screen->getWidth(), GFX_SCREEN_MASK_ALL, 255, 0, 0);
 	}
 }
 
@@ -240,8 +238,7 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 	byte priority = _addToFlag ? _priority : 0;
 	byte clearColor;
 	bool compression = true;
-	byte curByte;
-	int16 y, lastY, x, leftX, rightX;
+	int16 y, lastY, leftX, rightX;
 	int pixelCount;
 	uint16 width, height;
 
@@ -341,9 +338,13 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 		leftX = displayArea.left + drawX;
 		rightX = MIN<int16>(displayWidth + leftX, displayArea.right);
 
-		uint16 sourcePixelSkipPerRow = 0;
-		if (width > rightX - leftX)
-			sourcePixelSkipPerRow = width - (rightX - leftX);
+		// Only the part of the cel inside the clip area gets drawn. The clip area
+		// is the display area, unless kFrameout only redraws parts of the screen
+		Common::Rect clipArea = _coordAdjuster->pictureGetClipArea();
+		int16 clipTopY = MAX<int16>(y, clipArea.top);
+		int16 clipBottomY = MIN<int16>(lastY, clipArea.bottom);
+		int16 clipLeftX = MAX<int16>(leftX, clipArea.left);
+		int16 clipRightX = MIN<int16>(rightX, clipArea.right);
 
 		// Change clearcolor to white, if we dont add to an existing picture. That way we will paint everything on screen
 		// but white and that won't matter because the screen is supposed to be already white. It seems that most (if not all)
@@ -355,41 +356,15 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 
 		byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL | GFX_SCREEN_MASK_PRIORITY;
 
-		ptr = celBitmap;
-		ptr += skipCelBitmapPixels;
-		ptr += skipCelBitmapLines * width;
-		if (!_mirroredFlag) {
-			// Draw bitmap to screen
-			x = leftX;
-			while (y < lastY) {
-				curByte = *ptr++;
-				if ((curByte != clearColor) && (priority >= _screen->getPriority(x, y)))
-					_screen->putPixel(x, y, drawMask, curByte, priority, 0);
-
-				x++;
-
-				if (x >= rightX) {
-					ptr += sourcePixelSkipPerRow;
-					x = leftX;
-					y++;
-				}
-			}
-		} else {
-			// Draw bitmap to screen (mirrored)
-			x = rightX - 1;
-			while (y < lastY) {
-				curByte = *ptr++;
-				if ((curByte != clearColor) && (priority >= _screen->getPriority(x, y)))
-					_screen->putPixel(x, y, drawMask, curByte, priority, 0);
-
-				if (x == leftX) {
-					ptr += sourcePixelSkipPerRow;
-					x = rightX;
-					y++;
-				}
-
-				x--;
-			}
+		// Every row of the cel bitmap starts width bytes after the previous one,
+		// mirrored pictures read each row from right to left
+		for (int16 curY = clipTopY; curY < clipBottomY; curY++) {
+			ptr = celBitmap + skipCelBitmapPixels + (skipCelBitmapLines + curY - y) * width;
+			if (!_mirroredFlag)
+				ptr += clipLeftX - leftX;
+			else
+				ptr += rightX - 1 - clipLeftX;
+			_screen->putCelSpan(clipLeftX, curY, clipRightX - clipLeftX, ptr, _mirroredFlag, clearColor, drawMask, priority);
 		}
 	}
 
@@ -956,14 +931,15 @@ void GfxPicture::vectorFloodFill(int16 x, int16 y, byte color, byte priority, by
 		p = stack.pop();
 		if ((matchedMask = _screen->isFillMatch(p.x, p.y, matchMask, searchColor, searchPriority, searchControl, isEGA)) == 0) // already filled
 			continue;
-		_screen->putPixel(p.x, p.y, screenMask, color, priority, control);
 		w = p.x;
 		e = p.x;
 		// moving west and east pointers as long as there is a matching color to fill
 		while (w > l && (matchedMask = _screen->isFillMatch(w - 1, p.y, matchMask, searchColor, searchPriority, searchControl, isEGA)))
-			_screen->putPixel(--w, p.y, screenMask, color, priority, control);
+			w--;
 		while (e < r && (matchedMask = _screen->isFillMatch(e + 1, p.y, matchMask, searchColor, searchPriority, searchControl, isEGA)))
-			_screen->putPixel(++e, p.y, screenMask, color, priority, control);
+			e++;
+		// the whole line segment gets filled at once
+		_screen->putPixelSpan(w, p.y, e - w + 1, screenMask, color, priority, control);
 		// checking lines above and below for possible flood targets
 		a_set = b_set = 0;
 		while (w <= e) {
@@ -1120,12 +1096,10 @@ static const byte vectorPatternTextureOffset[128] = {
 
 void GfxPicture::vectorPatternBox(Common::Rect box, byte color, byte prio, byte control) {
 	byte flag = _screen->getDrawingMask(color, prio, control);
-	int y, x;
+	int y;
 
 	for (y = box.top; y < box.bottom; y++) {
-		for (x = box.left; x < box.right; x++) {
-			_screen->putPixel(x, y, flag, color, prio, control);
-		}
+		_screen->putPixelSpan(box.left, y, box.width(), flag, color, prio, control);
 	}
 }
 
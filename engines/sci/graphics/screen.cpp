@@ -230,6 +230,84 @@ void GfxScreen::putPixel(int x, int y, byte drawMask, byte color, byte priority,
 		_controlScreen[offset] = control;
 }
 
+/**
+ * Puts a horizontal run of pixels with the same color, priority and control
+ * onto the screens. Every screen gets filled with a single memset(), which is
+ * a lot faster than calling putPixel() for each pixel of the run.
+ */
+void GfxScreen::putPixelSpan(int x, int y, int width, byte drawMask, byte color, byte priority, byte control) {
+	if (width <= 0)
+		return;
+
+	int offset = y * _width + x;
+
+	if (drawMask & GFX_SCREEN_MASK_VISUAL) {
+		memset(_visualScreen + offset, color, width);
+		if (!_upscaledHires) {
+			memset(_displayScreen + offset, color, width);
+		} else {
+			for (int displayY = _upscaledMapping[y]; displayY < _upscaledMapping[y + 1]; displayY++)
+				memset(_displayScreen + displayY * _displayWidth + x * 2, color, width * 2);
+		}
+	}
+	if (drawMask & GFX_SCREEN_MASK_PRIORITY)
+		memset(_priorityScreen + offset, priority, width);
+	if (drawMask & GFX_SCREEN_MASK_CONTROL)
+		memset(_controlScreen + offset, control, width);
+}
+
+/**
+ * Puts a row of cel pixels onto the screens. Pixels of clearColor and pixels
+ * behind something with a higher priority are skipped, all other pixels are
+ * collected into runs, which get copied at once. When mirrored is set, data
+ * points to the rightmost pixel and the row gets read backwards.
+ */
+void GfxScreen::putCelSpan(int x, int y, int width, const byte *data, bool mirrored, byte clearColor, byte drawMask, byte priority) {
+	int offset = y * _width + x;
+	int dataStep = mirrored ? -1 : 1;
+	byte *priorityPtr = _priorityScreen + offset;
+	int pixelNr = 0;
+
+	while (pixelNr < width) {
+		// Skip over everything that is not going to be drawn
+		while (pixelNr < width && (data[pixelNr * dataStep] == clearColor || priority < priorityPtr[pixelNr]))
+			pixelNr++;
+
+		int runStart = pixelNr;
+		while (pixelNr < width && data[pixelNr * dataStep] != clearColor && priority >= priorityPtr[pixelNr])
+			pixelNr++;
+
+		int runLength = pixelNr - runStart;
+		if (!runLength)
+			break;
+
+		if (drawMask & GFX_SCREEN_MASK_VISUAL) {
+			byte *visualPtr = _visualScreen + offset + runStart;
+			const byte *runData = data + runStart * dataStep;
+			if (!mirrored) {
+				memcpy(visualPtr, runData, runLength);
+			} else {
+				for (int i = 0; i < runLength; i++)
+					visualPtr[i] = runData[-i];
+			}
+
+			if (!_upscaledHires) {
+				memcpy(_displayScreen + offset + runStart, visualPtr, runLength);
+			} else {
+				for (int displayY = _upscaledMapping[y]; displayY < _upscaledMapping[y + 1]; displayY++) {
+					byte *displayPtr = _displayScreen + displayY * _displayWidth + (x + runStart) * 2;
+					for (int i = 0; i < runLength; i++) {
+						*displayPtr++ = visualPtr[i];
+						*displayPtr++ = visualPtr[i];
+					}
+				}
+			}
+		}
+		if (drawMask & GFX_SCREEN_MASK_PRIORITY)
+			memset(priorityPtr + runStart, priority, runLength);
+	}
+}
+
 /**
  * This is used to put font pixels onto the screen - we adjust differently, so that we won't
  *  do triple pixel lines in any case on upscaled hires. That way the font will not get distorted
@@ -284,8 +362,7 @@ void GfxScreen::drawLine(Common::Point startPoint, Common::Point endPoint, byte
 	if (top == bottom) {
 		if (right < left)
 			SWAP(right, left);
-		for (int i = left; i <= right; i++)
-			putPixel(i, top, drawMask, color, priority, control);
+		putPixelSpan(left, top, right - left + 1, drawMask, color, priority, control);
 		return;
 	}
 	// vertical line
@@ -81,6 +81,8 @@ public:
 
 	byte getDrawingMask(byte color, byte prio, byte control);
 	void putPixel(int x, int y, byte drawMask, byte color, byte prio, byte control);
+	void putPixelSpan(int x, int y, int width, byte drawMask, byte color, byte prio, byte control);
+	void putCelSpan(int x, int y, int width, const byte *data, bool mirrored, byte clearColor, byte drawMask, byte prio);
 	void putFontPixel(int startingY, int x, int y, byte color);
 	void putPixelOnDisplay(int x, int y, byte color);
 	void drawLine(Common::Point startPoint, Common::Point endPoint, byte color, byte prio, byte control);
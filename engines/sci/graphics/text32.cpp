@@ -31,6 +31,7 @@
 #include "sci/graphics/cache.h"
 #include "sci/graphics/compare.h"
 #include "sci/graphics/font.h"
+#include "sci/graphics/frameout.h"
 #include "sci/graphics/screen.h"
 #include "sci/graphics/text32.h"
 
@@ -52,6 +53,9 @@ GfxText32::~GfxText32() {
 reg_t GfxText32::createTextBitmap(reg_t textObject, uint16 maxWidth, uint16 maxHeight, reg_t prevHunk) {
 	reg_t stringObject = readSelector(_segMan, textObject, SELECTOR(text));
 
+	// The bitmap may be reused, so kFrameout has to redraw the item in any case
+	g_sci->_gfxFrameout->invalidateScreenItem(textObject);
+
 	// The object in the text selector of the item can be either a raw string
 	// or a Str object. In the latter case, we need to access the object's data
 	// selector to get the raw string.
@@ -218,6 +222,33 @@ void GfxText32::drawTextBitmap(int16 x, int16 y, Common::Rect planeRect, reg_t t
 	}
 }
 
+/**
+ * Returns the screen area (in low-res screen coordinates) that drawTextBitmap()
+ * would touch for the given text object, or an empty rect if nothing is drawn.
+ */
+Common::Rect GfxText32::getTextBitmapRect(int16 x, int16 y, Common::Rect planeRect, reg_t textObject) {
+	reg_t hunkId = readSelector(_segMan, textObject, SELECTOR(bitmap));
+	if (hunkId.isNull() || x < 0 || y < 0)
+		return Common::Rect();
+
+	byte *memoryPtr = _segMan->getHunkPointer(hunkId);
+	if (!memoryPtr)
+		return Common::Rect();
+
+	int16 width = READ_LE_UINT16(memoryPtr);
+	int16 height = READ_LE_UINT16(memoryPtr + 2);
+
+	// Upscaled fonts are drawn directly on the display, round their size up
+	if (_screen->fontIsUpscaled()) {
+		width = (width * _screen->getWidth() + _screen->getDisplayWidth() - 1) / _screen->getDisplayWidth() + 1;
+		height = (height * _screen->getHeight() + _screen->getDisplayHeight() - 1) / _screen->getDisplayHeight() + 1;
+	}
+
+	Common::Rect textRect(width, height);
+	textRect.translate(planeRect.left + x, planeRect.top + y);
+	return textRect;
+}
+
 int16 GfxText32::GetLongest(const char *text, int16 maxWidth, GfxFont *font) {
 	uint16 curChar = 0;
 	int16 maxChars = 0, curCharCount = 0;
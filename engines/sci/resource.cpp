@@ -25,6 +25,8 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/memstream.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 #include "sci/resource.h"
@@ -1965,40 +1967,41 @@ int Resource::readResourceInfo(ResVersion volVersion, Common::SeekableReadStream
 	return (compression == kCompUnknown) ? SCI_ERROR_UNKNOWN_COMPRESSION : SCI_ERROR_NONE;
 }
 
-int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file) {
-	int errorNum;
-	uint32 szPacked = 0;
-	ResourceCompression compression = kCompUnknown;
-
-	// fill resource info
-	errorNum = readResourceInfo(volVersion, file, szPacked, compression);
-	if (errorNum)
-		return errorNum;
-
-	// getting a decompressor
-	Decompressor *dec = NULL;
+static Decompressor *createDecompressor(ResourceCompression compression) {
 	switch (compression) {
 	case kCompNone:
-		dec = new Decompressor;
-		break;
+		return new Decompressor;
 	case kCompHuffman:
-		dec = new DecompressorHuffman;
-		break;
+		return new DecompressorHuffman;
 	case kCompLZW:
 	case kCompLZW1:
 	case kCompLZW1View:
 	case kCompLZW1Pic:
-		dec = new DecompressorLZW(compression);
-		break;
+		return new DecompressorLZW(compression);
 	case kCompDCL:
-		dec = new DecompressorDCL;
-		break;
+		return new DecompressorDCL;
 #ifdef ENABLE_SCI32
 	case kCompSTACpack:
-		dec = new DecompressorLZS;
-		break;
+		return new DecompressorLZS;
 #endif
 	default:
+		return NULL;
+	}
+}
+
+int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file) {
+	int errorNum;
+	uint32 szPacked = 0;
+	ResourceCompression compression = kCompUnknown;
+
+	// fill resource info
+	errorNum = readResourceInfo(volVersion, file, szPacked, compression);
+	if (errorNum)
+		return errorNum;
+
+	// getting a decompressor
+	Decompressor *dec = createDecompressor(compression);
+	if (!dec) {
 		error("Resource %s: Compression method %d not supported", _id.toString().c_str(), compression);
 		return SCI_ERROR_UNKNOWN_COMPRESSION;
 	}
@@ -2013,6 +2016,109 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	return errorNum;
 }
 
+// A resource located by benchmarkDecompression()
+struct PackedResource {
+	Resource *res;
+	int32 dataOffset;
+	uint32 packedSize;
+};
+
+void ResourceManager::benchmarkDecompression(DecompressionStats *stats, int repetitions) {
+	// Resources are decompressed in batches from memory, so that reading the
+	// volumes doesn't get measured, and the timer resolution doesn't matter
+	enum {
+		kBatchSize = 1024 * 1024
+	};
+
+	Common::Array<PackedResource> packed[kCompDCL + 1];
+
+	memset(stats, 0, sizeof(DecompressionStats) * (kCompDCL + 1));
+
+	for (ResourceMap::iterator it = _resMap.begin(); it != _resMap.end(); ++it) {
+		Resource *res = it->_value;
+
+		if (res->_source->getSourceType() != kSourceVolume)
+			continue;
+
+		Common::SeekableReadStream *fileStream = getVolumeFile(res->_source);
+		if (!fileStream)
+			continue;
+		fileStream->seek(res->_fileOffset, SEEK_SET);
+
+		PackedResource entry;
+		ResourceCompression compression;
+		entry.res = res;
+
+		if (!res->readResourceInfo(_volVersion, fileStream, entry.packedSize, compression) && compression != kCompUnknown) {
+			entry.dataOffset = fileStream->pos();
+			packed[compression].push_back(entry);
+		}
+
+		if (res->_source->_resourceFile)
+			delete fileStream;
+	}
+
+	for (int compression = 0; compression <= kCompDCL; compression++) {
+		Decompressor *dec = createDecompressor((ResourceCompression)compression);
+		if (!dec)
+			continue;
+
+		uint i = 0;
+		while (i < packed[compression].size()) {
+			// Read the next batch
+			Common::Array<byte *> batchData;
+			Common::Array<uint32> batchSizes;
+			uint32 batchSize = 0;
+			uint first = i;
+
+			while (i < packed[compression].size() && batchSize < kBatchSize) {
+				const PackedResource &entry = packed[compression][i++];
+				Common::SeekableReadStream *fileStream = getVolumeFile(entry.res->_source);
+				byte *data = NULL;
+
+				if (fileStream) {
+					data = new byte[entry.packedSize];
+					fileStream->seek(entry.dataOffset, SEEK_SET);
+					fileStream->read(data, entry.packedSize);
+					if (entry.res->_source->_resourceFile)
+						delete fileStream;
+				}
+
+				batchData.push_back(data);
+				batchSizes.push_back(entry.packedSize);
+				batchSize += entry.packedSize;
+			}
+
+			// Decompress it
+			uint32 startTime = g_system->getMillis();
+			for (int r = 0; r < repetitions; r++) {
+				for (uint j = 0; j < batchData.size(); j++) {
+					if (!batchData[j])
+						continue;
+
+					uint32 size = packed[compression][first + j].res->size;
+					byte *dest = new byte[size];
+					Common::MemoryReadStream stream(batchData[j], batchSizes[j]);
+					dec->unpack(&stream, dest, batchSizes[j], size);
+					delete[] dest;
+				}
+			}
+			stats[compression].time += g_system->getMillis() - startTime;
+
+			for (uint j = 0; j < batchData.size(); j++) {
+				if (batchData[j]) {
+					stats[compression].resources++;
+					stats[compression].packedSize += batchSizes[j];
+					stats[compression].unpackedSize += packed[compression][first + j].res->size;
+				}
+				delete[] batchData[j];
+			}
+		}
+
+		delete dec;
+	}
+}
+
 ResourceCompression ResourceManager::getViewCompression() {
 	int viewsTested = 0;
 
@@ -371,6 +371,22 @@ public:
 	 */
 	reg_t findGameObject(bool addSci11ScriptOffset = true);
 
+	struct DecompressionStats {
+		uint32 resources;
+		uint32 packedSize;
+		uint32 unpackedSize;
+		uint32 time;	///< in milliseconds
+	};
+
+	/**
+	 * Decompresses all resources stored in resource volumes and measures the
+	 * time needed per compression method. Used by the debugger.
+	 * @param stats			Array of kCompDCL + 1 entries, indexed by the
+	 *						compression method, to be filled with the results
+	 * @param repetitions	How often every resource gets decompressed
+	 */
+	void benchmarkDecompression(DecompressionStats *stats, int repetitions);
+
 	/**
 	 * Converts a map resource type to our type
 	 * @param sciType The type from the map/patch
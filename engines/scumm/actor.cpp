@@ -1544,6 +1544,8 @@ Actor *ScummEngine::derefActorSafe(int id, const char *errmsg) const {
 void ScummEngine::processActors() {
 	int numactors = 0;
 
+	_costumeCelCache->nextFrame();
+
 	// Make a list of all actors in this room
 	for (int i = 1; i < _numActors; i++) {
 		if (_game.version == 8 && _actors[i]->_layer < 0)
@@ -542,7 +542,7 @@ byte AkosRenderer::drawLimb(const Actor *a, int limb) {
 void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	const byte *mask, *src;
 	byte *dst;
-	byte len, maskbit;
+	byte maskbit;
 	int y;
 	uint16 color, height, pcolor;
 	const byte *scaleytab;
@@ -550,90 +550,78 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	bool skip_column = false;
 
 	y = v1.y;
-	src = _srcptr;
+	src = _vm->_costumeCelCache->getCel(v1.celStart, _width, _height, v1.mask, v1.shr) + v1.celColumn * _height;
 	dst = v1.destptr;
-	len = v1.replen;
-	color = v1.repcolor;
 	height = _height;
 
 	scaleytab = &v1.scaletable[v1.scaleYindex];
 	maskbit = revBitMask(v1.x & 7);
 	mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
 
-	if (len)
-		goto StartPos;
-
 	do {
-		len = *src++;
-		color = len >> v1.shr;
-		len &= v1.mask;
-		if (!len)
-			len = *src++;
-
-		do {
-			if (_scaleY == 255 || *scaleytab++ < _scaleY) {
-				if (_actorHitMode) {
-					if (color && y == _actorHitY && v1.x == _actorHitX) {
-						_actorHitResult = true;
-						return;
-					}
-				} else {
-					masked = (y < v1.boundsRect.top || y >= v1.boundsRect.bottom) || (v1.x < 0 || v1.x >= v1.boundsRect.right) || (*mask & maskbit);
-
-					if (color && !masked && !skip_column) {
-						pcolor = _palette[color];
-						if (_shadow_mode == 1) {
-							if (pcolor == 13)
-								pcolor = _shadow_table[*dst];
-						} else if (_shadow_mode == 2) {
-							error("codec1_spec2"); // TODO
-						} else if (_shadow_mode == 3) {
-							if (_vm->_game.features & GF_16BIT_COLOR) {
-								uint16 srcColor = (pcolor >> 1) & 0x7DEF;
-								uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
-								pcolor = srcColor + dstColor;
-							} else if (_vm->_game.heversion >= 90) {
-								pcolor = (pcolor << 8) + *dst;
-								pcolor = xmap[pcolor];
-							} else if (pcolor < 8) {
-								pcolor = (pcolor << 8) + *dst;
-								pcolor = _shadow_table[pcolor];
-							}
-						}
-						if (_vm->_bytesPerPixel == 2) {
-							WRITE_UINT16(dst, pcolor);
-						} else {
-							*dst = pcolor;
+		color = *src++;
+
+		if (_scaleY == 255 || *scaleytab++ < _scaleY) {
+			if (_actorHitMode) {
+				if (color && y == _actorHitY && v1.x == _actorHitX) {
+					_actorHitResult = true;
+					return;
+				}
+			} else {
+				masked = (y < v1.boundsRect.top || y >= v1.boundsRect.bottom) || (v1.x < 0 || v1.x >= v1.boundsRect.right) || (*mask & maskbit);
+
+				if (color && !masked && !skip_column) {
+					pcolor = _palette[color];
+					if (_shadow_mode == 1) {
+						if (pcolor == 13)
+							pcolor = _shadow_table[*dst];
+					} else if (_shadow_mode == 2) {
+						error("codec1_spec2"); // TODO
+					} else if (_shadow_mode == 3) {
+						if (_vm->_game.features & GF_16BIT_COLOR) {
+							uint16 srcColor = (pcolor >> 1) & 0x7DEF;
+							uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
+							pcolor = srcColor + dstColor;
+						} else if (_vm->_game.heversion >= 90) {
+							pcolor = (pcolor << 8) + *dst;
+							pcolor = xmap[pcolor];
+						} else if (pcolor < 8) {
+							pcolor = (pcolor << 8) + *dst;
+							pcolor = _shadow_table[pcolor];
 						}
 					}
+					if (_vm->_bytesPerPixel == 2) {
+						WRITE_UINT16(dst, pcolor);
+					} else {
+						*dst = pcolor;
+					}
 				}
-				dst += _out.pitch;
-				mask += _numStrips;
-				y++;
 			}
-			if (!--height) {
-				if (!--v1.skip_width)
-					return;
-				height = _height;
-				y = v1.y;
+			dst += _out.pitch;
+			mask += _numStrips;
+			y++;
+		}
+		if (!--height) {
+			if (!--v1.skip_width)
+				return;
+			height = _height;
+			y = v1.y;
 
-				scaleytab = &v1.scaletable[v1.scaleYindex];
+			scaleytab = &v1.scaletable[v1.scaleYindex];
 
-				if (_scaleX == 255 || v1.scaletable[v1.scaleXindex] < _scaleX) {
-					v1.x += v1.scaleXstep;
-					if (v1.x < 0 || v1.x >= v1.boundsRect.right)
-						return;
-					maskbit = revBitMask(v1.x & 7);
-					v1.destptr += v1.scaleXstep * _vm->_bytesPerPixel;
-					skip_column = false;
-				} else
-					skip_column = true;
-				v1.scaleXindex += v1.scaleXstep;
-				dst = v1.destptr;
-				mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
-			}
-		StartPos:;
-		} while (--len);
+			if (_scaleX == 255 || v1.scaletable[v1.scaleXindex] < _scaleX) {
+				v1.x += v1.scaleXstep;
+				if (v1.x < 0 || v1.x >= v1.boundsRect.right)
+					return;
+				maskbit = revBitMask(v1.x & 7);
+				v1.destptr += v1.scaleXstep * _vm->_bytesPerPixel;
+				skip_column = false;
+			} else
+				skip_column = true;
+			v1.scaleXindex += v1.scaleXstep;
+			dst = v1.destptr;
+			mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
+		}
 	} while (1);
 }
 
@@ -940,6 +928,8 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 		return 0;
 
 	v1.replen = 0;
+	v1.celStart = _srcptr;
+	v1.celColumn = 0;
 
 	if (_mirror) {
 		if (!use_scaling)
@@ -57,6 +57,7 @@ byte BaseCostumeRenderer::drawCostume(const VirtScreen &vs, int numStrips, const
 }
 
 void BaseCostumeRenderer::codec1_ignorePakCols(Codec1 &v1, int num) {
+	v1.celColumn = num;
 	num *= _height;
 
 	do {
@@ -88,4 +89,105 @@ bool ScummEngine::isCostumeInUse(int cost) const {
 	return false;
 }
 
+CostumeCelCache::CostumeCelCache() : _memoryUsage(0), _useCounter(0) {
+	_frameDecodes = _frameHits = 0;
+	_lastFrameDecodes = _lastFrameHits = 0;
+	_totalDecodes = _totalHits = 0;
+}
+
+CostumeCelCache::~CostumeCelCache() {
+	clear();
+}
+
+const byte *CostumeCelCache::getCel(const byte *src, int width, int height, byte mask, byte shr) {
+	CelMap::iterator it = _cels.find(src);
+	if (it != _cels.end()) {
+		Cel &cel = it->_value;
+		if (cel.width == width && cel.height == height && cel.mask == mask) {
+			cel.lastUse = ++_useCounter;
+			_frameHits++;
+			_totalHits++;
+			return cel.data;
+		}
+
+		_memoryUsage -= cel.width * cel.height;
+		free(cel.data);
+		_cels.erase(it);
+	}
+
+	const uint32 size = width * height;
+	while (_memoryUsage + size > kMemoryBudget && !_cels.empty())
+		removeLeastRecentlyUsed();
+
+	Cel cel;
+	cel.data = (byte *)malloc(MAX<uint32>(size, 1));
+	cel.width = width;
+	cel.height = height;
+	cel.mask = mask;
+	cel.lastUse = ++_useCounter;
+
+	// Decode the runs. A run length of 0 is followed by the real length,
+	// where 0 again means 256.
+	const byte *rle = src;
+	byte *dst = cel.data;
+	uint32 left = size;
+	while (left) {
+		byte len = *rle++;
+		const byte color = len >> shr;
+		len &= mask;
+		if (!len)
+			len = *rle++;
+
+		uint32 run = len ? len : 256;
+		if (run > left)
+			run = left;
+		memset(dst, color, run);
+		dst += run;
+		left -= run;
+	}
+
+	_cels[src] = cel;
+	_memoryUsage += size;
+	_frameDecodes++;
+	_totalDecodes++;
+
+	return cel.data;
+}
+
+void CostumeCelCache::clear() {
+	for (CelMap::iterator it = _cels.begin(); it != _cels.end(); ++it)
+		free(it->_value.data);
+	_cels.clear();
+	_memoryUsage = 0;
+}
+
+void CostumeCelCache::clearRange(const byte *start, uint32 size) {
+	const byte *end = start + size;
+	for (CelMap::iterator it = _cels.begin(); it != _cels.end(); ++it) {
+		if (it->_key >= start && it->_key < end) {
+			_memoryUsage -= it->_value.width * it->_value.height;
+			free(it->_value.data);
+			_cels.erase(it);
+		}
+	}
+}
+
+void CostumeCelCache::nextFrame() {
+	_lastFrameDecodes = _frameDecodes;
+	_lastFrameHits = _frameHits;
+	_frameDecodes = _frameHits = 0;
+}
+
+void CostumeCelCache::removeLeastRecentlyUsed() {
+	CelMap::iterator oldest = _cels.begin();
+	for (CelMap::iterator it = _cels.begin(); it != _cels.end(); ++it) {
+		if (it->_value.lastUse < oldest->_value.lastUse)
+			oldest = it;
+	}
+
+	_memoryUsage -= oldest->_value.width * oldest->_value.height;
+	free(oldest->_value.data);
+	_cels.erase(oldest);
+}
+
 } // End of namespace Scumm
@@ -24,6 +24,7 @@
 #define SCUMM_BASE_COSTUME_H
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "scumm/actor.h"		// for CostumeData
 
 namespace Scumm {
@@ -47,6 +48,70 @@ class Actor;
 class ScummEngine;
 struct VirtScreen;
 
+/**
+ * Cache of decoded costume cels.
+ *
+ * The cels of the classic and AKOS codec 1 costumes are RLE compressed, and
+ * every limb of every actor used to be decompressed every time it got drawn.
+ * The cache keeps the decoded color indices of recently drawn cels, column
+ * by column, so that redrawing a cel is a plain masked blit. Palette, shadow
+ * and mirroring are applied while drawing, so the decoded cels are shared by
+ * all actors using them.
+ *
+ * Cels are identified by the address of their RLE data, so the cache has to
+ * be cleared whenever a costume resource is freed.
+ */
+class CostumeCelCache {
+public:
+	CostumeCelCache();
+	~CostumeCelCache();
+
+	/**
+	 * Returns the cel with the given RLE data, decoded into width * height
+	 * color indices, column by column.
+	 */
+	const byte *getCel(const byte *src, int width, int height, byte mask, byte shr);
+
+	void clear();
+
+	/** Drops the cels whose data lies in the given memory block. */
+	void clearRange(const byte *start, uint32 size);
+
+	/** Starts counting decodes and cache hits for a new frame. */
+	void nextFrame();
+
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+	uint getNumCels() const { return _cels.size(); }
+
+	uint32 _frameDecodes, _frameHits;
+	uint32 _lastFrameDecodes, _lastFrameHits;
+	uint32 _totalDecodes, _totalHits;
+
+private:
+	enum {
+		kMemoryBudget = 1024 * 1024
+	};
+
+	struct Cel {
+		byte *data;
+		int width, height;
+		byte mask;
+		uint32 lastUse;
+	};
+
+	struct CelHash {
+		uint operator()(const byte *ptr) const { return (uint)(size_t)ptr; }
+	};
+
+	typedef Common::HashMap<const byte *, Cel, CelHash> CelMap;
+
+	CelMap _cels;
+	uint32 _memoryUsage;
+	uint32 _useCounter;
+
+	void removeLeastRecentlyUsed();
+};
+
 class BaseCostumeLoader {
 protected:
 	ScummEngine *_vm;
@@ -122,6 +187,8 @@ public:
 		// These ones aren't accessed from ARM code.
 		Common::Rect boundsRect;
 		int scaleXindex, scaleYindex;
+		const byte *celStart;	// start of the cel's RLE data
+		int celColumn;			// first column to draw, see codec1_ignorePakCols()
 	};
 
 	BaseCostumeRenderer(ScummEngine *scumm) {
@@ -229,6 +229,8 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 		return 0;
 
 	v1.replen = 0;
+	v1.celStart = _srcptr;
+	v1.celColumn = 0;
 
 	if (_mirror) {
 		if (!use_scaling)
@@ -429,7 +431,7 @@ extern "C" int ClassicProc3RendererShadowARM(int _scaleY,
 void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 	const byte *mask, *src;
 	byte *dst;
-	byte len, maskbit;
+	byte maskbit;
 	int y;
 	uint color, height, pcolor;
 	byte scaleIndexY;
@@ -456,65 +458,53 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 #endif /* USE_ARM_COSTUME_ASM */
 
 	y = v1.y;
-	src = _srcptr;
+	src = _vm->_costumeCelCache->getCel(v1.celStart, _width, _height, v1.mask, v1.shr) + v1.celColumn * _height;
 	dst = v1.destptr;
-	len = v1.replen;
-	color = v1.repcolor;
 	height = _height;
 
 	scaleIndexY = _scaleIndexY;
 	maskbit = revBitMask(v1.x & 7);
 	mask = v1.mask_ptr + v1.x / 8;
 
-	if (len)
-		goto StartPos;
-
 	do {
-		len = *src++;
-		color = len >> v1.shr;
-		len &= v1.mask;
-		if (!len)
-			len = *src++;
+		color = *src++;
 
-		do {
-			if (_scaleY == 255 || v1.scaletable[scaleIndexY++] < _scaleY) {
-				masked = (y < 0 || y >= _out.h) || (v1.x < 0 || v1.x >= _out.w) || (v1.mask_ptr && (mask[0] & maskbit));
+		if (_scaleY == 255 || v1.scaletable[scaleIndexY++] < _scaleY) {
+			masked = (y < 0 || y >= _out.h) || (v1.x < 0 || v1.x >= _out.w) || (v1.mask_ptr && (mask[0] & maskbit));
 
-				if (color && !masked) {
-					if (_shadow_mode & 0x20) {
+			if (color && !masked) {
+				if (_shadow_mode & 0x20) {
+					pcolor = _shadow_table[*dst];
+				} else {
+					pcolor = _palette[color];
+					if (pcolor == 13 && _shadow_table)
 						pcolor = _shadow_table[*dst];
-					} else {
-						pcolor = _palette[color];
-						if (pcolor == 13 && _shadow_table)
-							pcolor = _shadow_table[*dst];
-					}
-					*dst = pcolor;
 				}
-				dst += _out.pitch;
-				mask += _numStrips;
-				y++;
+				*dst = pcolor;
 			}
-			if (!--height) {
-				if (!--v1.skip_width)
-					return;
-				height = _height;
-				y = v1.y;
+			dst += _out.pitch;
+			mask += _numStrips;
+			y++;
+		}
+		if (!--height) {
+			if (!--v1.skip_width)
+				return;
+			height = _height;
+			y = v1.y;
 
-				scaleIndexY = _scaleIndexY;
+			scaleIndexY = _scaleIndexY;
 
-				if (_scaleX == 255 || v1.scaletable[_scaleIndexX] < _scaleX) {
-					v1.x += v1.scaleXstep;
-					if (v1.x < 0 || v1.x >= _out.w)
-						return;
-					maskbit = revBitMask(v1.x & 7);
-					v1.destptr += v1.scaleXstep;
-				}
-				_scaleIndexX += v1.scaleXstep;
-				dst = v1.destptr;
-				mask = v1.mask_ptr + v1.x / 8;
+			if (_scaleX == 255 || v1.scaletable[_scaleIndexX] < _scaleX) {
+				v1.x += v1.scaleXstep;
+				if (v1.x < 0 || v1.x >= _out.w)
+					return;
+				maskbit = revBitMask(v1.x & 7);
+				v1.destptr += v1.scaleXstep;
 			}
-		StartPos:;
-		} while (--len);
+			_scaleIndexX += v1.scaleXstep;
+			dst = v1.destptr;
+			mask = v1.mask_ptr + v1.x / 8;
+		}
 	} while (1);
 }
 
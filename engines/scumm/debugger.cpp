@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/file.h"
 #include "common/str.h"
@@ -27,9 +28,14 @@
 #include "common/util.h"
 
 #include "scumm/actor.h"
+#include "scumm/base-costume.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/he/intern_he.h"
+#include "scumm/he/sprite_he.h"
+#include "scumm/he/wiz_he.h"
 #include "scumm/imuse/imuse.h"
+#include "scumm/imuse_digi/dimuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
@@ -37,13 +43,19 @@
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
+bool isDebugChannelActive(int channel) {
+	// FIXME: Still spew all debug at -d9, for crashes in startup etc.
+	//	  Add setting from commandline ( / abstract channel interface)
+	return DebugMan.isDebugChannelEnabled(channel) || (gDebugLevel >= 9);
+}
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
 
-	// FIXME: Still spew all debug at -d9, for crashes in startup etc.
-	//	  Add setting from commandline ( / abstract channel interface)
-	if (!DebugMan.isDebugChannelEnabled(channel) && (gDebugLevel < 9))
+	if (!isDebugChannelActive(channel))
 		return;
 
 	va_start(va, s);
@@ -72,12 +84,15 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("box",       WRAP_METHOD(ScummDebugger, Cmd_PrintBox));
 	DCmd_Register("matrix",    WRAP_METHOD(ScummDebugger, Cmd_PrintBoxMatrix));
 	DCmd_Register("camera",    WRAP_METHOD(ScummDebugger, Cmd_Camera));
+	DCmd_Register("screenstats", WRAP_METHOD(ScummDebugger, Cmd_ScreenStats));
+	DCmd_Register("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 	DCmd_Register("room",      WRAP_METHOD(ScummDebugger, Cmd_Room));
 	DCmd_Register("objects",   WRAP_METHOD(ScummDebugger, Cmd_PrintObjects));
 	DCmd_Register("object",    WRAP_METHOD(ScummDebugger, Cmd_Object));
 	DCmd_Register("script",    WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
+	DCmd_Register("opcodes",   WRAP_METHOD(ScummDebugger, Cmd_Opcodes));
 	DCmd_Register("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
 
 	if (_vm->_game.id == GID_LOOM)
@@ -97,6 +112,13 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 
 	DCmd_Register("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
+#ifdef ENABLE_HE
+	if (_vm->_game.heversion >= 71)
+		DCmd_Register("wizbench", WRAP_METHOD(ScummDebugger, Cmd_WizBench));
+	if (_vm->_game.heversion >= 90)
+		DCmd_Register("spriterects", WRAP_METHOD(ScummDebugger, Cmd_SpriteRects));
+#endif
+
 	DCmd_Register("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
 }
 
@@ -155,6 +177,16 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 				DebugPrintf("Specify a music resource # or \"all\".\n");
 			}
 			return true;
+#ifdef ENABLE_SCUMM_7_8
+		} else if (!strcmp(argv[1], "cache") && _vm->_imuseDigital) {
+			BundleBlockCache *cache = _vm->_imuseDigital->getBundleBlockCache();
+			DebugPrintf("Bundle block cache: %d of %d blocks used\n", cache->getNumUsedBlocks(), BundleBlockCache::kNumBlocks);
+			DebugPrintf("  %d hits, %d misses, %d blocks read ahead, %d evictions\n",
+						cache->_hits, cache->_misses, cache->_readAheads, cache->_evictions);
+			if (argc > 2 && !strcmp(argv[2], "reset"))
+				cache->resetStats();
+			return true;
+#endif
 		}
 	}
 
@@ -162,9 +194,60 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 	DebugPrintf("  panic - Stop all music tracks\n");
 	DebugPrintf("  play # - Play a music resource\n");
 	DebugPrintf("  stop # - Stop a music resource\n");
+	if (_vm->_imuseDigital)
+		DebugPrintf("  cache [reset] - Show (and reset) the bundle block cache statistics\n");
 	return true;
 }
 
+#ifdef ENABLE_HE
+bool ScummDebugger::Cmd_WizBench(int argc, const char **argv) {
+	int repetitions = (argc > 1) ? atoi(argv[1]) : 10;
+	if (repetitions <= 0) {
+		DebugPrintf("Syntax: wizbench [<repetitions>]\n");
+		return true;
+	}
+
+	Wiz::DecompressionStats stats;
+	((ScummEngine_v71he *)_vm)->_wiz->benchmarkDecompression(repetitions, stats);
+
+	DebugPrintf("Decoded %d image states (%d pixels) %d times in %d ms\n", stats.images, stats.pixels, repetitions, stats.time);
+	if (stats.time)
+		DebugPrintf("%d Kpixels/s\n", (int)((double)stats.pixels * repetitions / stats.time));
+	return true;
+}
+
+bool ScummDebugger::Cmd_SpriteRects(int argc, const char **argv) {
+	Sprite *sprite = ((ScummEngine_v90he *)_vm)->_sprite;
+	Sprite::RedrawStats &stats = sprite->_redrawStats;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			sprite->_showRedrawRects = true;
+			DebugPrintf("Outlining restored and redrawn sprite areas\n");
+		} else if (!strcmp(argv[1], "off")) {
+			sprite->_showRedrawRects = false;
+			DebugPrintf("No longer outlining sprite areas\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			memset(&stats, 0, sizeof(stats));
+			DebugPrintf("Sprite redraw statistics reset\n");
+		} else {
+			DebugPrintf("Syntax: spriterects [on|off|reset]\n");
+		}
+		return true;
+	}
+
+	DebugPrintf("%d frames: %d background rects restored (%d pixels)\n",
+		stats.frames, stats.restoredRects, stats.restoredPixels);
+	DebugPrintf("%d sprites redrawn completely, %d clipped to the dirty area (%d pixels)\n",
+		stats.fullRedraws, stats.clippedRedraws, stats.redrawPixels);
+	if (stats.frames)
+		DebugPrintf("Average per frame: %d pixels restored, %d pixels redrawn\n",
+			stats.restoredPixels / stats.frames, stats.redrawPixels / stats.frames);
+	DebugPrintf("Use \"%s on|off\" to toggle outlining, \"%s reset\" to reset the statistics\n", argv[0], argv[0]);
+	return true;
+}
+#endif
+
 bool ScummDebugger::Cmd_Room(int argc, const char **argv) {
 	if (argc > 1) {
 		int room = atoi(argv[1]);
@@ -330,6 +413,92 @@ bool ScummDebugger::Cmd_PrintScript(int argc, const char **argv) {
 	return true;
 }
 
+struct ProfileLine {
+	uint32 key;
+	OpcodeProfiler::Entry entry;
+};
+
+static bool compareProfileLines(const ProfileLine &a, const ProfileLine &b) {
+	if (a.entry.time != b.entry.time)
+		return a.entry.time > b.entry.time;
+	return a.entry.count > b.entry.count;
+}
+
+static const char *getScriptWhereName(byte where) {
+	static const char *const names[] = { "inventory", "room", "global", "local", "flobject" };
+	return (where < ARRAYSIZE(names)) ? names[where] : "unknown";
+}
+
+bool ScummDebugger::Cmd_Opcodes(int argc, const char **argv) {
+	OpcodeProfiler &profiler = _vm->_opcodeProfiler;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			profiler._enabled = true;
+			DebugPrintf("Opcode profiling enabled\n");
+		} else if (!strcmp(argv[1], "off")) {
+			profiler._enabled = false;
+			DebugPrintf("Opcode profiling disabled\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			profiler.reset();
+			DebugPrintf("Opcode profile reset\n");
+		} else if (!strcmp(argv[1], "dump") && argc > 2) {
+			Common::DumpFile out;
+			if (!out.open(argv[2])) {
+				DebugPrintf("Could not open '%s' for writing\n", argv[2]);
+				return true;
+			}
+
+			out.writeString("type,id,name,count,time_ms\n");
+			for (int i = 0; i < 256; i++) {
+				const OpcodeProfiler::Entry &e = profiler._opcodes[i];
+				if (e.count)
+					out.writeString(Common::String::format("opcode,0x%02X,%s,%u,%u\n", i, _vm->getOpcodeDesc(i), e.count, e.time));
+			}
+			for (OpcodeProfiler::ScriptMap::const_iterator i = profiler._scripts.begin(); i != profiler._scripts.end(); ++i)
+				out.writeString(Common::String::format("script,%d,%s,%u,%u\n", OpcodeProfiler::getScriptNumber(i->_key),
+					getScriptWhereName(OpcodeProfiler::getScriptWhere(i->_key)), i->_value.count, i->_value.time));
+			out.finalize();
+			DebugPrintf("Opcode profile written to '%s'\n", argv[2]);
+		} else {
+			DebugPrintf("Syntax: opcodes [on|off|reset|dump <filename>]\n");
+		}
+		return true;
+	}
+
+	if (!profiler._enabled)
+		DebugPrintf("Opcode profiling is disabled, use \"%s on\" to enable it\n", argv[0]);
+
+	Common::Array<ProfileLine> lines;
+	for (int i = 0; i < 256; i++) {
+		if (profiler._opcodes[i].count) {
+			ProfileLine line = { (uint32)i, profiler._opcodes[i] };
+			lines.push_back(line);
+		}
+	}
+	Common::sort(lines.begin(), lines.end(), compareProfileLines);
+
+	DebugPrintf("Opcode                          Count    Time (ms)\n");
+	for (uint i = 0; i < lines.size() && i < 15; i++)
+		DebugPrintf("0x%02X %-24s %8u %8u\n", lines[i].key, _vm->getOpcodeDesc(lines[i].key),
+			lines[i].entry.count, lines[i].entry.time);
+
+	lines.clear();
+	for (OpcodeProfiler::ScriptMap::const_iterator i = profiler._scripts.begin(); i != profiler._scripts.end(); ++i) {
+		ProfileLine line = { i->_key, i->_value };
+		lines.push_back(line);
+	}
+	Common::sort(lines.begin(), lines.end(), compareProfileLines);
+
+	DebugPrintf("\nScript                      Opcodes    Time (ms)\n");
+	for (uint i = 0; i < lines.size() && i < 10; i++)
+		DebugPrintf("%-9s %5d              %8u %8u\n", getScriptWhereName(OpcodeProfiler::getScriptWhere(lines[i].key)),
+			OpcodeProfiler::getScriptNumber(lines[i].key), lines[i].entry.count, lines[i].entry.time);
+
+	DebugPrintf("Times include nested scripts. Use \"%s dump <filename>\" to write the full profile as CSV\n", argv[0]);
+	return true;
+}
+
 bool ScummDebugger::Cmd_Actor(int argc, const char **argv) {
 	Actor *a;
 	int actnum;
@@ -413,6 +582,11 @@ bool ScummDebugger::Cmd_PrintActor(int argc, const char **argv) {
 						 a->_scalex, a->getFacing(), _vm->_classData[a->_number]);
 	}
 	DebugPrintf("\n");
+
+	const CostumeCelCache *cache = _vm->_costumeCelCache;
+	DebugPrintf("Costume cels: last frame %d decoded, %d cached; total %d decoded, %d cached\n",
+				cache->_lastFrameDecodes, cache->_lastFrameHits, cache->_totalDecodes, cache->_totalHits);
+	DebugPrintf("Costume cel cache: %d cels, %d bytes\n", cache->getNumCels(), cache->getMemoryUsage());
 	return true;
 }
 
@@ -552,6 +726,57 @@ bool ScummDebugger::Cmd_Camera(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_ScreenStats(int argc, const char **argv) {
+	ScummEngine::ScreenStats &stats = _vm->_screenStats;
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		memset(&stats, 0, sizeof(stats));
+		DebugPrintf("Screen statistics reset\n");
+		return true;
+	}
+
+	DebugPrintf("Last frame: %d copyRectToScreen calls, %d pixels\n", stats.lastUploads, stats.lastPixels);
+	if (stats.frames)
+		DebugPrintf("Average over %d frames: %d calls, %d pixels, at most %d calls\n",
+			stats.frames, stats.uploads / stats.frames, stats.pixels / stats.frames, stats.maxUploads);
+	DebugPrintf("Use \"%s reset\" to reset the statistics\n", argv[0]);
+
+	return true;
+}
+
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager::Stats &stats = _vm->_res->_stats;
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		memset(&stats, 0, sizeof(stats));
+		DebugPrintf("Resource statistics reset\n");
+		return true;
+	}
+
+	DebugPrintf("Heap: %d of %d bytes in use\n", _vm->_res->getAllocatedSize(), _vm->_res->getMaxHeapThreshold());
+	DebugPrintf("Hits: %d, misses: %d (%d of them reloads), preloads: %d\n",
+		stats.hits, stats.misses, stats.reloads, stats.preloads);
+	DebugPrintf("Expired: %d resources, %d bytes\n", stats.evictions, stats.evictedBytes);
+
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		const ResourceManager::ResTypeData &data = _vm->_res->_types[type];
+		int loaded = 0, loads = 0;
+		uint32 size = 0;
+		for (uint idx = 0; idx < data.size(); idx++) {
+			if (data[idx]._address) {
+				loaded++;
+				size += data[idx]._size;
+			}
+			loads += data[idx]._loadCount;
+		}
+		if (loaded || loads)
+			DebugPrintf("  %-12s %4d loaded, %8d bytes, %5d loads\n", nameOfResType(type), loaded, size, loads);
+	}
+
+	DebugPrintf("Use \"%s reset\" to reset the statistics\n", argv[0]);
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintBox(int argc, const char **argv) {
 	int num, i = 0;
 
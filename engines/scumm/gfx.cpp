@@ -527,6 +527,17 @@ void ScummEngine::drawDirtyScreenParts() {
 		_shakeFrame = 0;
 		_system->setShakePos(0);
 	}
+
+	// Update the statistics shown by the "screenstats" debugger command
+	_screenStats.frames++;
+	_screenStats.uploads += _screenUploads;
+	_screenStats.pixels += _screenUploadPixels;
+	_screenStats.lastUploads = _screenUploads;
+	_screenStats.lastPixels = _screenUploadPixels;
+	if (_screenUploads > _screenStats.maxUploads)
+		_screenStats.maxUploads = _screenUploads;
+	_screenUploads = 0;
+	_screenUploadPixels = 0;
 }
 
 void ScummEngine_v6::drawDirtyScreenParts() {
@@ -573,26 +584,49 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
+	// Neighboring dirty strips are coalesced into one rectangle, as long as
+	// at least half of that rectangle is dirty. Compositing and blitting a
+	// few clean pixels is cheaper than doing it for every strip on its own.
+	int start = -1;
+	int top = 0, bottom = 0;
+	int dirtyArea = 0;
 
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
+	for (int i = 0; i <= _gdi->_numStrips; i++) {
+		int stripTop = 0, stripBottom = 0;
+
+		if (i < _gdi->_numStrips && vs->bdirty[i]) {
+			stripTop = vs->tdirty[i];
+			stripBottom = vs->bdirty[i];
 			vs->tdirty[i] = vs->h;
 			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
-				continue;
+		}
+
+		const bool dirty = stripTop < stripBottom;
+
+		if (start >= 0) {
+			if (dirty) {
+				const int newTop = MIN(top, stripTop);
+				const int newBottom = MAX(bottom, stripBottom);
+				const int newDirtyArea = dirtyArea + 8 * (stripBottom - stripTop);
+
+				if ((i + 1 - start) * 8 * (newBottom - newTop) <= 2 * newDirtyArea) {
+					top = newTop;
+					bottom = newBottom;
+					dirtyArea = newDirtyArea;
+					continue;
+				}
 			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+
+			drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
+			start = -1;
+		}
+
+		if (dirty) {
+			start = i;
+			top = stripTop;
+			bottom = stripBottom;
+			dirtyArea = 8 * (stripBottom - stripTop);
 		}
-		start = i + 1;
 	}
 }
 
@@ -656,6 +690,8 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifndef DISABLE_TOWNS_DUAL_LAYER_MODE
 		if (_game.platform == Common::kPlatformFMTowns) {
 			towns_drawStripToScreen(vs, x, y, x, top, width, height);
+			_screenUploads++;
+			_screenUploadPixels += width * height;
 			return;
 		} else
 #endif
@@ -756,6 +792,8 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 
 					width = 240; // Fix right strip
 					_system->copyRectToScreen((const byte *)blackbuf, 16, 0, 0, 16, 240); // Fix left strip
+					_screenUploads++;
+					_screenUploadPixels += 16 * 240;
 				}
 			}
 
@@ -764,6 +802,8 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 
 	// Finally blit the whole thing to the screen
 	_system->copyRectToScreen((const byte *)src, pitch, x, y, width, height);
+	_screenUploads++;
+	_screenUploadPixels += width * height;
 }
 
 // CGA
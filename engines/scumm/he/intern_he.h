@@ -409,6 +409,7 @@ protected:
 class ScummEngine_v90he : public ScummEngine_v80he {
 	friend class LogicHE;
 	friend class MoviePlayer;
+	friend class ScummDebugger;
 	friend class Sprite;
 
 protected:
@@ -450,6 +451,7 @@ protected:
 
 	virtual void scummLoop(int delta);
 	virtual void scummLoop_handleDrawing();
+	virtual void drawDirtyScreenParts();
 	virtual void runBootscript();
 
 	virtual void processInput();
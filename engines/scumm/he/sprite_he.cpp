@@ -22,6 +22,8 @@
 
 #ifdef ENABLE_HE
 
+#include "common/system.h"
+
 #include "scumm/he/intern_he.h"
 #include "scumm/resource.h"
 #include "scumm/saveload.h"
@@ -38,7 +40,9 @@ Sprite::Sprite(ScummEngine_v90he *vm)
 	_vm(vm),
 	_spriteGroups(0),
 	_spriteTable(0),
-	_activeSpritesTable(0) {
+	_activeSpritesTable(0),
+	_showRedrawRects(false) {
+	memset(&_redrawStats, 0, sizeof(_redrawStats));
 }
 
 Sprite::~Sprite() {
@@ -1082,49 +1086,74 @@ void Sprite::resetTables(bool refreshScreen) {
 	_numSpritesToProcess = 0;
 }
 
+// Add r to the list of areas to restore, merging it with every rect it
+// overlaps so the same pixels are never restored twice. Once the list is
+// full, r is merged into whichever rect grows the least.
+static void addRestoreRect(Common::Rect *rects, int &numRects, int maxRects, Common::Rect r) {
+	int i = 0;
+	while (i < numRects) {
+		if (rects[i].intersects(r)) {
+			r.extend(rects[i]);
+			rects[i] = rects[--numRects];
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+
+	if (numRects < maxRects) {
+		rects[numRects++] = r;
+		return;
+	}
+
+	int best = 0;
+	int bestGrowth = 0;
+	for (i = 0; i < numRects; i++) {
+		Common::Rect u(rects[i]);
+		u.extend(r);
+		int growth = u.width() * u.height() - rects[i].width() * rects[i].height();
+		if (i == 0 || growth < bestGrowth) {
+			best = i;
+			bestGrowth = growth;
+		}
+	}
+	rects[best].extend(r);
+}
+
 void Sprite::resetBackground() {
-	int xmin, xmax, ymin, ymax;
-	xmin = ymin = 1234;
-	xmax = ymax = -1234;
-	bool firstLoop = true;
-	bool refreshScreen = false;
+	Common::Rect rects[kMaxRestoreRects];
+	int numRects = 0;
+
+	_redrawRects.clear();
+	_redrawStats.frames++;
 
 	for (int i = 0; i < _numSpritesToProcess; ++i) {
 		SpriteInfo *spi = _activeSpritesTable[i];
 		if (!(spi->flags & kSFImageless) && (spi->flags & kSFChanged)) {
 			spi->flags &= ~kSFChanged;
 			if (spi->bbox.left <= spi->bbox.right && spi->bbox.top <= spi->bbox.bottom) {
+				// Only the old position of each changed sprite is restored,
+				// rather than the bounding box of all of them, so sprites
+				// lying in between are left alone.
 				if (spi->flags & kSFBlitDirectly) {
 					_vm->restoreBackgroundHE(spi->bbox, USAGE_BIT_RESTORED);
-				} else if (firstLoop) {
-					xmin = spi->bbox.left;
-					ymin = spi->bbox.top;
-					xmax = spi->bbox.right;
-					ymax = spi->bbox.bottom;
-					firstLoop = false;
-					refreshScreen = true;
+					addRedrawRect(spi->bbox);
+					_redrawStats.restoredRects++;
+					_redrawStats.restoredPixels += spi->bbox.width() * spi->bbox.height();
 				} else {
-					if (xmin > spi->bbox.left) {
-						xmin = spi->bbox.left;
-					}
-					if (ymin > spi->bbox.top) {
-						ymin = spi->bbox.top;
-					}
-					if (xmax < spi->bbox.right) {
-						xmax = spi->bbox.right;
-					}
-					if (ymax < spi->bbox.bottom) {
-						ymax = spi->bbox.bottom;
-					}
-					refreshScreen = true;
+					addRestoreRect(rects, numRects, kMaxRestoreRects, spi->bbox);
 				}
 				if (!(spi->flags & kSFNeedRedraw) && spi->image)
 					spi->flags |= kSFNeedRedraw;
 			}
 		}
 	}
-	if (refreshScreen) {
-		_vm->restoreBackgroundHE(Common::Rect(xmin, ymin, xmax, ymax), USAGE_BIT_RESTORED);
+
+	for (int i = 0; i < numRects; i++) {
+		_vm->restoreBackgroundHE(rects[i], USAGE_BIT_RESTORED);
+		addRedrawRect(rects[i]);
+		_redrawStats.restoredRects++;
+		_redrawStats.restoredPixels += rects[i].width() * rects[i].height();
 	}
 }
 
@@ -1143,6 +1172,7 @@ void Sprite::setRedrawFlags(bool checkZOrder) {
 				for (; lp < rp; lp++) {
 					if (vs->tdirty[lp] < vs->h && spi->bbox.bottom >= vs->tdirty[lp] && spi->bbox.top <= vs->bdirty[lp]) {
 						spi->flags |= kSFNeedRedraw;
+						spi->clipToDirty = true;
 						break;
 					}
 				}
@@ -1220,6 +1250,7 @@ void Sprite::sortActiveSprites() {
 
 			spi->id = i;
 			spi->zorder = spi->priority + groupZorder;
+			spi->clipToDirty = false;
 
 			_activeSpritesTable[_numSpritesToProcess++] = spi;
 		}
@@ -1238,6 +1269,7 @@ void Sprite::processImages(bool arg) {
 	Common::Rect *bboxPtr;
 	int angle, scale;
 	int32 w, h;
+	bool clipToDirty;
 	WizParameters wiz;
 
 	for (int i = 0; i < _numSpritesToProcess; i++) {
@@ -1257,6 +1289,8 @@ void Sprite::processImages(bool arg) {
 		}
 
 		spi->flags &= ~kSFNeedRedraw;
+		clipToDirty = spi->clipToDirty;
+		spi->clipToDirty = false;
 		image = spi->image;
 		imageState = spi->imageState;
 		_vm->_wiz->getWizImageSpot(spi->image, spi->imageState, spr_wiz_x, spr_wiz_y);
@@ -1326,7 +1360,7 @@ void Sprite::processImages(bool arg) {
 		if (spr_flags & kSFRemapPalette)
 			wiz.img.flags |= kWIFRemapPalette;
 		if (spi->field_84) {
-			wiz.processFlags |= 0x200000;
+			wiz.processFlags |= kWPFZBuffer;
 			wiz.img.field_390 = spi->field_84;
 			wiz.img.zorder = spi->priority;
 		}
@@ -1369,10 +1403,105 @@ void Sprite::processImages(bool arg) {
 			wiz.processFlags |= kWPFDstResNum;
 			wiz.dstResNum = _spriteGroups[spi->group].image;
 		}
+
+		// A sprite which did not change itself only has to be redrawn where
+		// the screen has been dirtied so far this frame (by restored
+		// backgrounds or the sprites and actors drawn below it). Outside of
+		// that the previous frame is still intact.
+		Common::Rect dirty;
+		if (clipToDirty && image && !_vm->_fullRedraw && !_vm->_wiz->_rectOverrideEnabled &&
+			!(wiz.processFlags & (kWPFClipBox | kWPFDstResNum | kWPFRotate | kWPFScaled | kWPFZBuffer)) &&
+			!(spr_flags & (kSFDoubleBuffered | kSFBlitDirectly)) && getDirtyBounds(spi->bbox, dirty)) {
+			wiz.processFlags |= kWPFClipBox;
+			wiz.box = dirty;
+			_redrawStats.clippedRedraws++;
+		} else {
+			dirty = spi->bbox;
+			_redrawStats.fullRedraws++;
+		}
+		if (dirty.isValidRect()) {
+			_redrawStats.redrawPixels += dirty.width() * dirty.height();
+			addRedrawRect(dirty);
+		}
+
 		_vm->_wiz->displayWizComplexImage(&wiz);
 	}
 }
 
+/**
+ * Compute the part of bbox that lies in the dirty area of the main virtual
+ * screen, rounded out to whole strips. Returns false if there is none.
+ */
+bool Sprite::getDirtyBounds(const Common::Rect &bbox, Common::Rect &bounds) const {
+	VirtScreen *vs = &_vm->_virtscr[kMainVirtScreen];
+	bool found = false;
+
+	int32 lp = MAX((int32)0, (int32)bbox.left / 8);
+	int32 rp = MIN((int32)_vm->_gdi->_numStrips, (int32)(bbox.right + 7) / 8);
+	for (; lp < rp; lp++) {
+		if (vs->tdirty[lp] >= vs->h || bbox.bottom < vs->tdirty[lp] || bbox.top > vs->bdirty[lp])
+			continue;
+
+		Common::Rect strip(lp * 8, vs->tdirty[lp], lp * 8 + 8, vs->bdirty[lp]);
+		if (found)
+			bounds.extend(strip);
+		else
+			bounds = strip;
+		found = true;
+	}
+
+	if (!found || !bounds.intersects(bbox))
+		return false;
+
+	bounds.clip(bbox);
+	return true;
+}
+
+void Sprite::addRedrawRect(const Common::Rect &r) {
+	if (_showRedrawRects)
+		_redrawRects.push_back(r);
+}
+
+/**
+ * Outline the areas restored and redrawn during the last frame directly on
+ * the screen. The outlines are not part of the virtual screen; the outlines
+ * of the previous frame are erased by copying those areas over again.
+ */
+void Sprite::drawRedrawRects() {
+	VirtScreen *vs = &_vm->_virtscr[kMainVirtScreen];
+	uint i;
+
+	for (i = 0; i < _shownRedrawRects.size(); i++) {
+		const Common::Rect &r = _shownRedrawRects[i];
+		_vm->drawStripToScreen(vs, r.left, r.width(), r.top, r.bottom);
+	}
+	_shownRedrawRects.clear();
+
+	if (!_showRedrawRects || _redrawRects.empty())
+		return;
+
+	Graphics::Surface *screen = _vm->_system->lockScreen();
+	if (!screen)
+		return;
+
+	const uint32 color = (screen->format.bytesPerPixel == 1) ? 0xFF : screen->format.RGBToColor(255, 0, 255);
+	for (i = 0; i < _redrawRects.size(); i++) {
+		Common::Rect r = _redrawRects[i];
+		r.clip(Common::Rect(vs->w, vs->h));
+		if (r.width() < 1 || r.height() < 1)
+			continue;
+		_shownRedrawRects.push_back(r);
+
+		r.translate(0, vs->topline - _vm->_screenTop);
+		r.clip(Common::Rect(screen->w, screen->h));
+		if (r.width() > 0 && r.height() > 0)
+			screen->frameRect(r, color);
+	}
+
+	_vm->_system->unlockScreen();
+	_redrawRects.clear();
+}
+
 void Sprite::saveOrLoadSpriteData(Serializer *s) {
 	static const SaveLoadEntry spriteEntries[] = {
 		MKLINE(SpriteInfo, id, sleInt32, VER(48)),
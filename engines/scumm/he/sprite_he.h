@@ -23,6 +23,9 @@
 #if !defined(SCUMM_HE_SPRITE_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_SPRITE_HE_H
 
+#include "common/array.h"
+#include "common/rect.h"
+
 namespace Scumm {
 
 enum SpriteFlags {
@@ -80,6 +83,10 @@ struct SpriteInfo {
 	int32 classFlags;
 	int32 imgFlags;
 	int32 field_90;
+
+	// Not saved: set when the sprite only needs to be redrawn because
+	// something else dirtied part of it, so the redraw can be clipped.
+	bool clipToDirty;
 };
 
 struct SpriteGroup {
@@ -118,6 +125,19 @@ public:
 	void sortActiveSprites();
 	void processImages(bool arg);
 	void updateImages();
+	void drawRedrawRects();
+
+	struct RedrawStats {
+		uint32 frames;
+		uint32 restoredRects;	///< background rects restored
+		uint32 restoredPixels;
+		uint32 fullRedraws;		///< sprites redrawn completely
+		uint32 clippedRedraws;	///< sprites redrawn clipped to the dirty area
+		uint32 redrawPixels;	///< pixels covered by redrawn sprites
+	} _redrawStats;
+
+	/** If set, outline the areas restored and redrawn this frame. */
+	bool _showRedrawRects;
 
 	int findSpriteWithClassOf(int x, int y, int spriteGroupId, int d, int num, int *args);
 	int getSpriteClass(int spriteId, int num, int *args);
@@ -212,7 +232,17 @@ public:
 	void resetTables(bool refreshScreen);
 	void setSpriteImage(int spriteId, int imageNum);
 private:
+	enum {
+		kMaxRestoreRects = 16
+	};
+
+	void addRedrawRect(const Common::Rect &r);
+	bool getDirtyBounds(const Common::Rect &bbox, Common::Rect &bounds) const;
+
 	ScummEngine_v90he *_vm;
+
+	Common::Array<Common::Rect> _redrawRects;
+	Common::Array<Common::Rect> _shownRedrawRects;
 };
 
 } // End of namespace Scumm
@@ -369,6 +369,22 @@ void Wiz::writeColor(uint8 *dstPtr, int dstType, uint16 color) {
 	}
 }
 
+// Returns whether writeColor() stores colors for the given destination in
+// native byte order rather than little endian, so that the loops writing
+// whole runs and spans of pixels only need to decide this once.
+static bool isNativeDstType(int dstType) {
+	switch (dstType) {
+	case kDstCursor:
+	case kDstScreen:
+		return true;
+	case kDstMemory:
+	case kDstResource:
+		return false;
+	default:
+		error("isNativeDstType: Unknown dstType %d", dstType);
+	}
+}
+
 #ifdef USE_RGB_COLOR
 void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr) {
 	Common::Rect r1, r2;
@@ -701,6 +717,54 @@ void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, cons
 	}
 }
 
+template<int type>
+void Wiz::write16BitRun(uint8 *dstPtr, int dstInc, const uint8 *dataPtr, int count, int dstType) {
+	const bool native = isNativeDstType(dstType);
+	const uint16 col = READ_LE_UINT16(dataPtr);
+	if (type == kWizXMap) {
+		const uint16 srcColor = (col >> 1) & 0x7DEF;
+		while (count--) {
+			const uint16 newColor = srcColor + ((READ_UINT16(dstPtr) >> 1) & 0x7DEF);
+			WRITE_UINT16(dstPtr, native ? newColor : TO_LE_16(newColor));
+			dstPtr += dstInc;
+		}
+	}
+	if (type == kWizCopy) {
+		const uint16 value = native ? col : TO_LE_16(col);
+		while (count--) {
+			WRITE_UINT16(dstPtr, value);
+			dstPtr += dstInc;
+		}
+	}
+}
+
+template<int type>
+void Wiz::write16BitSpan(uint8 *dstPtr, int dstInc, const uint8 *dataPtr, int count, int dstType) {
+	const bool native = isNativeDstType(dstType);
+	if (type == kWizXMap) {
+		while (count--) {
+			const uint16 srcColor = (READ_LE_UINT16(dataPtr) >> 1) & 0x7DEF;
+			const uint16 newColor = srcColor + ((READ_UINT16(dstPtr) >> 1) & 0x7DEF);
+			WRITE_UINT16(dstPtr, native ? newColor : TO_LE_16(newColor));
+			dataPtr += 2;
+			dstPtr += dstInc;
+		}
+	}
+	if (type == kWizCopy) {
+		if (!native && dstInc == 2) {
+			// The data is little endian already
+			memcpy(dstPtr, dataPtr, count * 2);
+			return;
+		}
+		while (count--) {
+			const uint16 col = READ_LE_UINT16(dataPtr);
+			WRITE_UINT16(dstPtr, native ? col : TO_LE_16(col));
+			dataPtr += 2;
+			dstPtr += dstInc;
+		}
+	}
+}
+
 template<int type>
 void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
 	const uint8 *dataPtr, *dataPtrNext;
@@ -770,10 +834,8 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dstPtr += dstInc;
-					}
+					write16BitRun<type>(dstPtr, dstInc, dataPtr, code, dstType);
+					dstPtr += dstInc * code;
 					dataPtr += 2;
 				} else {
 					code = (code >> 2) + 1;
@@ -790,11 +852,9 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
-					}
+					write16BitSpan<type>(dstPtr, dstInc, dataPtr, code, dstType);
+					dataPtr += code * 2;
+					dstPtr += dstInc * code;
 				}
 			}
 		}
@@ -805,30 +865,66 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 #endif
 
 template<int type>
-void Wiz::write8BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+void Wiz::write8BitRun(uint8 *dstPtr, int dstInc, const uint8 *dataPtr, int count, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
 	if (bitDepth == 2) {
+		const bool native = isNativeDstType(dstType);
+		uint16 color = (type == kWizCopy) ? *dataPtr : READ_LE_UINT16(palPtr + *dataPtr * 2);
 		if (type == kWizXMap) {
-			uint16 color = READ_LE_UINT16(palPtr + *dataPtr * 2);
-			uint16 srcColor = (color >> 1) & 0x7DEF;
-			uint16 dstColor = (READ_UINT16(dstPtr) >> 1) & 0x7DEF;
-			uint16 newColor = srcColor + dstColor;
-			writeColor(dstPtr, dstType, newColor);
-		}
-		if (type == kWizRMap) {
-			writeColor(dstPtr, dstType, READ_LE_UINT16(palPtr + *dataPtr * 2));
-		}
-		if (type == kWizCopy) {
-			writeColor(dstPtr, dstType, *dataPtr);
+			const uint16 srcColor = (color >> 1) & 0x7DEF;
+			while (count--) {
+				const uint16 newColor = srcColor + ((READ_UINT16(dstPtr) >> 1) & 0x7DEF);
+				WRITE_UINT16(dstPtr, native ? newColor : TO_LE_16(newColor));
+				dstPtr += dstInc;
+			}
+		} else {
+			if (!native)
+				color = TO_LE_16(color);
+			while (count--) {
+				WRITE_UINT16(dstPtr, color);
+				dstPtr += dstInc;
+			}
 		}
 	} else {
 		if (type == kWizXMap) {
-			*dstPtr = xmapPtr[*dataPtr * 256 + *dstPtr];
+			const uint8 *xmap = xmapPtr + *dataPtr * 256;
+			while (count--) {
+				*dstPtr = xmap[*dstPtr];
+				dstPtr += dstInc;
+			}
+		} else {
+			// The run covers the same pixels whichever direction it is drawn in
+			const uint8 color = (type == kWizRMap) ? palPtr[*dataPtr] : *dataPtr;
+			memset((dstInc > 0) ? dstPtr : dstPtr - (count - 1), color, count);
+		}
+	}
+}
+
+template<int type>
+void Wiz::write8BitSpan(uint8 *dstPtr, int dstInc, const uint8 *dataPtr, int count, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	if (bitDepth == 2) {
+		const bool native = isNativeDstType(dstType);
+		while (count--) {
+			uint16 color = (type == kWizCopy) ? *dataPtr : READ_LE_UINT16(palPtr + *dataPtr * 2);
+			if (type == kWizXMap)
+				color = ((color >> 1) & 0x7DEF) + ((READ_UINT16(dstPtr) >> 1) & 0x7DEF);
+			WRITE_UINT16(dstPtr, native ? color : TO_LE_16(color));
+			dataPtr++;
+			dstPtr += dstInc;
 		}
-		if (type == kWizRMap) {
-			*dstPtr = palPtr[*dataPtr];
+	} else {
+		if (type == kWizCopy && dstInc == 1) {
+			memcpy(dstPtr, dataPtr, count);
+			return;
 		}
-		if (type == kWizCopy) {
-			*dstPtr = *dataPtr;
+		while (count--) {
+			if (type == kWizXMap)
+				*dstPtr = xmapPtr[*dataPtr * 256 + *dstPtr];
+			if (type == kWizRMap)
+				*dstPtr = palPtr[*dataPtr];
+			if (type == kWizCopy)
+				*dstPtr = *dataPtr;
+			dataPtr++;
+			dstPtr += dstInc;
 		}
 	}
 }
@@ -904,10 +1000,8 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dstPtr += dstInc;
-					}
+					write8BitRun<type>(dstPtr, dstInc, dataPtr, code, dstType, palPtr, xmapPtr, bitDepth);
+					dstPtr += dstInc * code;
 					dataPtr++;
 				} else {
 					code = (code >> 2) + 1;
@@ -924,11 +1018,9 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dataPtr++;
-						dstPtr += dstInc;
-					}
+					write8BitSpan<type>(dstPtr, dstInc, dataPtr, code, dstType, palPtr, xmapPtr, bitDepth);
+					dataPtr += code;
+					dstPtr += dstInc * code;
 				}
 			}
 		}
@@ -951,10 +1043,18 @@ void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uin
 	if (w <= 0 || h <= 0) {
 		return;
 	}
+	if (transColor == -1) {
+		while (h--) {
+			write8BitSpan<type>(dst, bitDepth, src, w, dstType, palPtr, NULL, bitDepth);
+			src += srcPitch;
+			dst += dstPitch;
+		}
+		return;
+	}
 	while (h--) {
 		for (int i = 0; i < w; ++i) {
 			uint8 col = src[i];
-			if (transColor == -1 || transColor != col) {
+			if (transColor != col) {
 				if (type == kWizRMap) {
 					if (bitDepth == 2) {
 						writeColor(dst + i * 2, dstType, READ_LE_UINT16(palPtr + col * 2));
@@ -2001,6 +2101,82 @@ void Wiz::flushWizBuffer() {
 	_imagesNum = 0;
 }
 
+void Wiz::benchmarkDecompression(int repetitions, DecompressionStats &stats) {
+	memset(&stats, 0, sizeof(stats));
+
+	uint8 *buffer = NULL;
+	uint32 bufferSize = 0;
+
+	for (int resNum = 1; resNum < (int)_vm->_res->_types[rtImage].size(); resNum++) {
+		const bool wasLoaded = _vm->_res->isResourceLoaded(rtImage, resNum);
+		if (!wasLoaded && _vm->_res->_types[rtImage][resNum]._roomoffs == RES_INVALID_OFFSET)
+			continue;
+
+		uint8 *dataPtr = _vm->getResourceAddress(rtImage, resNum);
+		if (!dataPtr)
+			continue;
+
+		const int numStates = getWizImageStates(resNum);
+		for (int state = 0; state < numStates; state++) {
+			const uint8 *wizh = _vm->findWrappedBlock(MKTAG('W','I','Z','H'), dataPtr, state, 0);
+			const uint8 *wizd = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dataPtr, state, 0);
+			if (!wizh || !wizd)
+				continue;
+
+			const uint32 comp   = READ_LE_UINT32(wizh + 0x0);
+			const uint32 width  = READ_LE_UINT32(wizh + 0x4);
+			const uint32 height = READ_LE_UINT32(wizh + 0x8);
+			const int bitDepth = (comp == 2 || comp == 5) ? 2 : _vm->_bytesPerPixel;
+			if (width == 0 || height == 0)
+				continue;
+			if (comp != 0 && comp != 1 && comp != 2 && comp != 5)
+				continue;
+#ifndef USE_RGB_COLOR
+			if (comp == 2 || comp == 5)
+				continue;
+#endif
+
+			const uint32 size = width * height * bitDepth;
+			if (size > bufferSize) {
+				free(buffer);
+				bufferSize = size;
+				buffer = (uint8 *)malloc(bufferSize);
+				assert(buffer);
+			}
+
+			const int pitch = width * bitDepth;
+			const uint32 startTime = _vm->_system->getMillis();
+			for (int i = 0; i < repetitions; i++) {
+				switch (comp) {
+				case 0:
+					copyRawWizImage(buffer, wizd, pitch, kDstMemory, width, height, 0, 0, width, height, NULL, 0, NULL, -1, bitDepth);
+					break;
+				case 1:
+					copyWizImage(buffer, wizd, pitch, kDstMemory, width, height, 0, 0, width, height, NULL, 0, NULL, NULL, bitDepth);
+					break;
+#ifdef USE_RGB_COLOR
+				case 2:
+					copyRaw16BitWizImage(buffer, wizd, pitch, kDstMemory, width, height, 0, 0, width, height, NULL, 0, -1);
+					break;
+				case 5:
+					copy16BitWizImage(buffer, wizd, pitch, kDstMemory, width, height, 0, 0, width, height, NULL, 0, NULL);
+					break;
+#endif
+				}
+			}
+			stats.time += _vm->_system->getMillis() - startTime;
+			stats.images++;
+			stats.pixels += width * height;
+		}
+
+		// Leave the resource cache the way we found it
+		if (!wasLoaded)
+			_vm->_res->nukeResource(rtImage, resNum);
+	}
+
+	free(buffer);
+}
+
 void Wiz::loadWizCursor(int resId, int palette) {
 	int32 x, y;
 	getWizImageSpot(resId, 0, x, y);
@@ -2068,7 +2244,7 @@ void Wiz::displayWizComplexImage(const WizParameters *params) {
 		shadow = params->img.shadow;
 	}
 	int field_390 = 0;
-	if (params->processFlags & 0x200000) {
+	if (params->processFlags & kWPFZBuffer) {
 		field_390 = params->img.field_390;
 		debug(0, "displayWizComplexImage() unhandled flag 0x200000");
 	}
@@ -130,7 +130,8 @@ enum WizProcessFlags {
 	kWPFFillColor = 0x20000,
 	kWPFClipBox2 = 0x40000,
 	kWPFMaskImg = 0x80000,
-	kWPFParams = 0x100000
+	kWPFParams = 0x100000,
+	kWPFZBuffer = 0x200000
 };
 
 enum {
@@ -192,6 +193,18 @@ public:
 
 	void flushWizBuffer();
 
+	struct DecompressionStats {
+		uint32 images;		// image states decoded
+		uint32 pixels;		// pixels decoded by each repetition
+		uint32 time;		// milliseconds spent decoding
+	};
+
+	/**
+	 * Decodes every state of every image resource of the game the given
+	 * number of times into a memory buffer, and measures the time spent.
+	 */
+	void benchmarkDecompression(int repetitions, DecompressionStats &stats);
+
 	void getWizImageSpot(int resId, int state, int32 &x, int32 &y);
 	void loadWizCursor(int resId, int palette);
 
@@ -226,8 +239,11 @@ public:
 
 #ifdef USE_RGB_COLOR
 	template<int type> static void write16BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *xmapPtr);
+	template<int type> static void write16BitRun(uint8 *dst, int dstInc, const uint8 *src, int count, int dstType);
+	template<int type> static void write16BitSpan(uint8 *dst, int dstInc, const uint8 *src, int count, int dstType);
 #endif
-	template<int type> static void write8BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void write8BitRun(uint8 *dst, int dstInc, const uint8 *src, int count, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void write8BitSpan(uint8 *dst, int dstInc, const uint8 *src, int count, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	static void writeColor(uint8 *dstPtr, int dstType, uint16 color);
 
 	int isWizPixelNonTransparent(const uint8 *data, int x, int y, int w, int h, uint8 bitdepth);
@@ -152,6 +152,8 @@ public:
 	void parseScriptCmds(int cmd, int soundId, int sub_cmd, int d, int e, int f, int g, int h);
 	void refreshScripts();
 	void flushTracks();
+	void readAheadTracks();
+	BundleBlockCache *getBundleBlockCache() { return _sound->getBundleBlockCache(); }
 	int getSoundStatus(int sound) const;
 	int32 getCurMusicPosInMs();
 	int32 getCurVoiceLipSyncWidth();
@@ -138,14 +138,73 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(BundleDirCache *cache) {
+BundleBlockCache::BundleBlockCache() {
+	_blocks = new Block[kNumBlocks];
+	for (int i = 0; i < kNumBlocks; i++) {
+		_blocks[i].bundle = -1;
+		_blocks[i].lastUse = 0;
+	}
+	_useCounter = 0;
+	resetStats();
+}
+
+BundleBlockCache::~BundleBlockCache() {
+	delete[] _blocks;
+}
+
+BundleBlockCache::Block *BundleBlockCache::find(int bundle, int32 sound, int32 number) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		Block &block = _blocks[i];
+		if (block.bundle == bundle && block.sound == sound && block.number == number) {
+			block.lastUse = ++_useCounter;
+			return &block;
+		}
+	}
+	return NULL;
+}
+
+BundleBlockCache::Block *BundleBlockCache::allocate(int bundle, int32 sound, int32 number) {
+	Block *block = &_blocks[0];
+	for (int i = 1; i < kNumBlocks && block->bundle != -1; i++) {
+		if (_blocks[i].bundle == -1 || _blocks[i].lastUse < block->lastUse)
+			block = &_blocks[i];
+	}
+
+	if (block->bundle != -1)
+		_evictions++;
+
+	block->bundle = bundle;
+	block->sound = sound;
+	block->number = number;
+	block->size = 0;
+	block->lastUse = ++_useCounter;
+	return block;
+}
+
+int BundleBlockCache::getNumUsedBlocks() const {
+	int count = 0;
+	for (int i = 0; i < kNumBlocks; i++) {
+		if (_blocks[i].bundle != -1)
+			count++;
+	}
+	return count;
+}
+
+void BundleBlockCache::resetStats() {
+	_hits = _misses = _readAheads = _evictions = 0;
+}
+
+BundleMgr::BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache) {
 	_cache = cache;
+	_blockCache = blockCache;
 	_bundleTable = NULL;
 	_compTable = NULL;
 	_numFiles = 0;
 	_numCompItems = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_bundleSlot = -1;
+	_readAheadBlock = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
 }
@@ -185,6 +244,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_bundleSlot = slot;
 	compressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -192,8 +252,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 	_indexTable = _cache->getIndexTable(slot);
 	assert(_bundleTable);
 	_compTableLoaded = false;
-	_outputSize = 0;
-	_lastBlock = -1;
+	_readAheadBlock = -1;
 
 	return true;
 }
@@ -205,9 +264,9 @@ void BundleMgr::close() {
 		_numFiles = 0;
 		_numCompItems = 0;
 		_compTableLoaded = false;
-		_lastBlock = -1;
-		_outputSize = 0;
+		_readAheadBlock = -1;
 		_curSampleId = -1;
+		_bundleSlot = -1;
 		free(_compTable);
 		_compTable = NULL;
 		free(_compInputBuff);
@@ -245,6 +304,41 @@ bool BundleMgr::loadCompTable(int32 index) {
 	return true;
 }
 
+BundleBlockCache::Block *BundleMgr::getBlock(int32 index, int32 number, bool readAhead) {
+	BundleBlockCache::Block *block = _blockCache->find(_bundleSlot, index, number);
+	if (block) {
+		if (!readAhead)
+			_blockCache->_hits++;
+		return block;
+	}
+
+	if (readAhead)
+		_blockCache->_readAheads++;
+	else
+		_blockCache->_misses++;
+
+	block = _blockCache->allocate(_bundleSlot, index, number);
+
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[number].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[number].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[number].size);
+	block->size = BundleCodecs::decompressCodec(_compTable[number].codec, _compInputBuff, block->data, _compTable[number].size);
+	if (block->size > BundleBlockCache::kBlockSize) {
+		error("_outputSize: %d", block->size);
+	}
+
+	return block;
+}
+
+void BundleMgr::readAhead() {
+	if (!_file->isOpen() || !_compTableLoaded || _readAheadBlock < 0)
+		return;
+
+	for (int32 i = _readAheadBlock; i < _readAheadBlock + kReadAheadBlocks && i < _numCompItems; i++)
+		getBlock(_curSampleId, i, true);
+}
+
 int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside);
 }
@@ -286,19 +380,10 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 	skip = (offset + headerSize) % 0x2000;
 
 	for (i = firstBlock; i <= lastBlock; i++) {
-		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
-			}
-			_lastBlock = i;
-		}
+		const BundleBlockCache::Block *block = getBlock(index, i, false);
+		_readAheadBlock = i + 1;
 
-		outputSize = _outputSize;
+		outputSize = block->size;
 
 		if (headerOutside) {
 			outputSize -= skip;
@@ -315,7 +400,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 		assert(finalSize + outputSize <= blocksFinalSize);
 
-		memcpy(*compFinal + finalSize, _compOutputBuff + skip, outputSize);
+		memcpy(*compFinal + finalSize, block->data + skip, outputSize);
 		finalSize += outputSize;
 
 		size -= outputSize;
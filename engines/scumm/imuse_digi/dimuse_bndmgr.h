@@ -63,6 +63,56 @@ public:
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * Cache of decompressed bundle blocks, shared by all BundleMgr instances.
+ *
+ * Blocks are identified by the bundle directory slot, the sound index and
+ * the block number, so tracks playing the same sound (e.g. while music
+ * crossfades into another region of the same song) share them, and blocks
+ * decompressed ahead of time by BundleMgr::readAhead() are found again by
+ * the iMuse callback.
+ */
+class BundleBlockCache {
+public:
+	enum {
+		kBlockSize = 0x2000,
+		kNumBlocks = 64
+	};
+
+	struct Block {
+		int bundle;
+		int32 sound;
+		int32 number;
+		int32 size;
+		uint32 lastUse;
+		byte data[kBlockSize];
+	};
+
+	BundleBlockCache();
+	~BundleBlockCache();
+
+	/** Returns the block if it is cached, NULL otherwise. */
+	Block *find(int bundle, int32 sound, int32 number);
+
+	/**
+	 * Returns a block to decompress the given data into, reusing the least
+	 * recently used one when the cache is full.
+	 */
+	Block *allocate(int bundle, int32 sound, int32 number);
+
+	int getNumUsedBlocks() const;
+	void resetStats();
+
+	uint32 _hits;			// requested blocks found in the cache
+	uint32 _misses;			// requested blocks which had to be decompressed
+	uint32 _readAheads;		// blocks decompressed ahead of time
+	uint32 _evictions;		// blocks dropped to make room for others
+
+private:
+	Block *_blocks;
+	uint32 _useCounter;
+};
+
 class BundleMgr {
 
 private:
@@ -73,7 +123,12 @@ private:
 		int32 codec;
 	};
 
+	enum {
+		kReadAheadBlocks = 2
+	};
+
 	BundleDirCache *_cache;
+	BundleBlockCache *_blockCache;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable;
 	CompTable *_compTable;
@@ -84,16 +139,16 @@ private:
 	BaseScummFile *_file;
 	bool _compTableLoaded;
 	int _fileBundleId;
-	byte _compOutputBuff[0x2000];
+	int _bundleSlot;
 	byte *_compInputBuff;
-	int _outputSize;
-	int _lastBlock;
+	int32 _readAheadBlock;
 
 	bool loadCompTable(int32 index);
+	BundleBlockCache::Block *getBlock(int32 index, int32 number, bool readAhead);
 
 public:
 
-	BundleMgr(BundleDirCache *_cache);
+	BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &compressed, bool errorFlag = false);
@@ -102,6 +157,12 @@ public:
 	int32 decompressSampleByName(const char *name, int32 offset, int32 size, byte **compFinal, bool headerOutside);
 	int32 decompressSampleByIndex(int32 index, int32 offset, int32 size, byte **compFinal, int header_size, bool headerOutside);
 	int32 decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside);
+
+	/**
+	 * Decompresses the blocks following the last block read into the block
+	 * cache, so that the next reads of the current sound do not have to.
+	 */
+	void readAhead();
 };
 
 } // End of namespace Scumm
@@ -195,6 +195,19 @@ void IMuseDigital::flushTracks() {
 	}
 }
 
+void IMuseDigital::readAheadTracks() {
+	Common::StackLock lock(_mutex, "IMuseDigital::readAheadTracks()");
+	debug(6, "readAheadTracks()");
+
+	// Decompress the bundle data the callback is going to need next from
+	// the engine loop, so the callback itself mostly finds it in the cache.
+	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
+		Track *track = _track[l];
+		if (track->used && !track->toBeRemoved && !track->souStreamUsed && track->soundDesc)
+			_sound->readAhead(track->soundDesc);
+	}
+}
+
 void IMuseDigital::refreshScripts() {
 	Common::StackLock lock(_mutex, "IMuseDigital::refreshScripts()");
 	debug(6, "refreshScripts()");
@@ -31,6 +31,7 @@ namespace Scumm {
 
 class ScummEngine;
 class BundleMgr;
+class BundleBlockCache;
 
 class ImuseDigiSndMgr {
 public:
@@ -115,6 +116,7 @@ private:
 	ScummEngine *_vm;
 	byte _disk;
 	BundleDirCache *_cacheBundleDir;
+	BundleBlockCache *_cacheBundleBlocks;
 
 	bool openMusicBundle(SoundDesc *sound, int &disk);
 	bool openVoiceBundle(SoundDesc *sound, int &disk);
@@ -146,6 +148,9 @@ public:
 	void getSyncSizeAndPtrById(SoundDesc *soundDesc, int number, int32 &sync_size, byte **sync_ptr);
 
 	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size);
+	void readAhead(SoundDesc *soundDesc);
+
+	BundleBlockCache *getBundleBlockCache() { return _cacheBundleBlocks; }
 };
 
 } // End of namespace Scumm
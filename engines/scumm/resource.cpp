@@ -20,11 +20,13 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/str.h"
 #ifndef MACOSX
 #include "common/config-manager.h"
 #endif
 
+#include "scumm/base-costume.h"
 #include "scumm/charset.h"
 #include "scumm/dialogs.h"
 #include "scumm/file.h"
@@ -609,10 +611,13 @@ void ScummEngine::ensureResourceLoaded(ResType type, ResId idx) {
 	if (type != rtCharset && idx == 0)
 		return;
 
-	if (idx <= _res->_types[type].size() && _res->_types[type][idx]._address)
+	if (idx <= _res->_types[type].size() && _res->_types[type][idx]._address) {
+		_res->noteAccess(type, idx, false);
 		return;
+	}
 
-	loadResource(type, idx);
+	if (loadResource(type, idx) && _res->_types[type][idx]._address)
+		_res->noteAccess(type, idx, true);
 
 	if (_game.version == 5 && type == rtRoom && (int)idx == _roomResource)
 		VAR(VAR_ROOM_FLAG) = 1;
@@ -844,6 +849,8 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_loadCount = 0;
+	_loadSize = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -872,6 +879,7 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 ResourceManager::~ResourceManager() {
@@ -897,7 +905,13 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	byte *ptr = _types[type][idx]._address;
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
-		_allocatedSize -= _types[type][idx]._size;
+		const uint32 size = _types[type][idx]._size;
+		_allocatedSize -= size;
+
+		// Decoded costume cels are keyed by the address of their data
+		if ((type == rtCostume || type == rtRoom) && _vm->_costumeCelCache)
+			_vm->_costumeCelCache->clearRange(ptr, size);
+
 		_types[type][idx].nuke();
 	}
 }
@@ -1032,10 +1046,54 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+void ResourceManager::noteAccess(ResType type, ResId idx, bool loaded) {
+	if (!loaded) {
+		_stats.hits++;
+		return;
+	}
+
+	Resource &res = _types[type][idx];
+	_stats.misses++;
+	if (res._loadCount)
+		_stats.reloads++;
+	if (res._loadCount < 0xFFFF)
+		res._loadCount++;
+	res._loadSize = res._size;
+}
+
+/**
+ * Rate how worthwhile it is to expire the given resource. Resources which
+ * have not been used for a long time and free a lot of memory score high.
+ * Resources which are expensive to load again score low: those from
+ * another room than the current one (which means seeking far or switching
+ * data files), and those which already had to be loaded again before.
+ */
+uint32 ResourceManager::getExpireScore(ResType type, ResId idx) const {
+	// Every load costs about as much as reading this many bytes
+	const uint32 loadOverhead = 16 * 1024;
+
+	const Resource &res = _types[type][idx];
+	double score = 256.0 * res.getResourceCounter() * res._size / (loadOverhead + res._size);
+
+	if (_vm->getResourceRoomNr(type, idx) != _vm->_roomResource)
+		score /= 2;
+	if (res._loadCount > 1)
+		score /= MIN<int>(res._loadCount, 8);
+
+	return (uint32)score;
+}
+
+struct ExpireCandidate {
+	ResType type;
+	ResId idx;
+	uint32 score;
+};
+
+static bool compareExpireCandidates(const ExpireCandidate &a, const ExpireCandidate &b) {
+	return a.score > b.score;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1048,37 +1106,84 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
+	// Collect all resources which may be expired, i.e. which can be
+	// reloaded from the data files and have not been used recently, then
+	// throw out the best candidates until enough memory is free.
+	Common::Array<ExpireCandidate> candidates;
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (_types[type]._mode != kDynamicResTypeMode) {
+			ResId idx = _types[type].size();
+			while (idx-- > 0) {
+				Resource &tmp = _types[type][idx];
+				if (!tmp.isLocked() && tmp.getResourceCounter() >= 2 && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+					ExpireCandidate candidate = { type, idx, getExpireScore(type, idx) };
+					candidates.push_back(candidate);
 				}
 			}
 		}
+	}
 
-		if (!best_type)
-			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+	Common::sort(candidates.begin(), candidates.end(), compareExpireCandidates);
+
+	for (uint i = 0; i < candidates.size() && size + _allocatedSize > _minHeapThreshold; i++) {
+		_stats.evictions++;
+		_stats.evictedBytes += _types[candidates[i].type][candidates[i].idx]._size;
+		nukeResource(candidates[i].type, candidates[i].idx);
+	}
 
 	increaseResourceCounters();
 
 	debugC(DEBUG_RESOURCE, "Expired resources, mem %d -> %d", oldAllocatedSize, _allocatedSize);
 }
 
+struct PreloadCandidate {
+	ResType type;
+	ResId idx;
+	uint32 offset;
+};
+
+static bool comparePreloadCandidates(const PreloadCandidate &a, const PreloadCandidate &b) {
+	return a.offset < b.offset;
+}
+
+void ResourceManager::preloadRoom(int room) {
+	static const ResType preloadTypes[] = { rtCostume, rtImage };
+
+	Common::Array<PreloadCandidate> candidates;
+	for (int i = 0; i < ARRAYSIZE(preloadTypes); i++) {
+		const ResType type = preloadTypes[i];
+		if (_types[type]._mode == kDynamicResTypeMode)
+			continue;
+		for (ResId idx = 1; idx < _types[type].size(); idx++) {
+			const Resource &res = _types[type][idx];
+			if (!res._address && res._loadCount && res._roomno == room && res._roomoffs != RES_INVALID_OFFSET) {
+				PreloadCandidate candidate = { type, idx, res._roomoffs };
+				candidates.push_back(candidate);
+			}
+		}
+	}
+
+	// Read the resources in the order they are stored in the room
+	Common::sort(candidates.begin(), candidates.end(), comparePreloadCandidates);
+
+	for (uint i = 0; i < candidates.size(); i++) {
+		Resource &res = _types[candidates[i].type][candidates[i].idx];
+
+		// Never push anything else out of memory for a preload
+		if (res._loadSize + _allocatedSize >= _maxHeapThreshold)
+			continue;
+
+		if (_vm->loadResource(candidates[i].type, candidates[i].idx) && res._address) {
+			_stats.preloads++;
+			if (res._loadCount < 0xFFFF)
+				res._loadCount++;
+			res._loadSize = res._size;
+		}
+	}
+
+	debugC(DEBUG_RESOURCE, "Preloaded room %d, mem %d", room, _allocatedSize);
+}
+
 void ResourceManager::freeResources() {
 	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 		ResId idx = _types[type].size();
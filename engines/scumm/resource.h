@@ -125,6 +125,19 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * How often this resource has been loaded from the game data files.
+		 * Unlike the rest of the state this survives nuke(), so resources
+		 * which keep being expired and loaded again can be told apart.
+		 */
+		uint16 _loadCount;
+
+		/**
+		 * The size this resource had when it was last loaded from the game
+		 * data files. Also survives nuke().
+		 */
+		uint32 _loadSize;
+
 	public:
 		Resource();
 		~Resource();
@@ -176,6 +189,15 @@ protected:
 	byte _expireCounter;
 
 public:
+	struct Stats {
+		uint32 hits;			///< ensureResourceLoaded() calls for resources already in memory
+		uint32 misses;			///< resources loaded from the data files
+		uint32 reloads;			///< misses for resources loaded before
+		uint32 evictions;		///< resources expired to free memory
+		uint32 evictedBytes;
+		uint32 preloads;		///< resources loaded by preloadRoom()
+	} _stats;
+
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
 
@@ -224,10 +246,26 @@ public:
 
 	void resourceStats();
 
+	/**
+	 * Load the resources of the given room which were needed during earlier
+	 * visits, while the room file is open anyway and as long as it does not
+	 * make other resources expire. Called by ScummEngine::startScene.
+	 */
+	void preloadRoom(int room);
+
+	/**
+	 * Record that a resource was requested, and whether it had to be loaded.
+	 */
+	void noteAccess(ResType type, ResId idx, bool loaded);
+
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+	uint32 getMaxHeapThreshold() const { return _maxHeapThreshold; }
+
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+	uint32 getExpireScore(ResType type, ResId idx) const;
 };
 
 } // End of namespace Scumm
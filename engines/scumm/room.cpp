@@ -131,6 +131,13 @@ void ScummEngine::startScene(int room, Actor *a, int objectNr) {
 	if (room != 0)
 		ensureResourceLoaded(rtRoom, room);
 
+	// Bring back the costumes and images this room used last time, as
+	// long as there is room for them. Reading them in one go, in file
+	// order, saves seeking back and forth once the room scripts ask for
+	// them.
+	if (room != 0 && _game.heversion >= 70)
+		_res->preloadRoom(_roomResource);
+
 	clearRoomObjects();
 
 	if (_currentRoom == 0) {
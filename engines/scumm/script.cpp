@@ -21,6 +21,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -454,8 +455,16 @@ void ScummEngine::refreshScriptPointer() {
 	}
 }
 
+void OpcodeProfiler::reset() {
+	memset(_opcodes, 0, sizeof(_opcodes));
+	_scripts.clear();
+}
+
 /** Execute a script - Read opcode, and execute it from the table */
 void ScummEngine::executeScript() {
+	// Only evaluate the trace arguments (which include a call to look up
+	// the opcode name) if they are going to be printed.
+	const bool traceOpcodes = isDebugChannelActive(DEBUG_OPCODES);
 	int c;
 	while (_currentScript != 0xFF) {
 
@@ -469,11 +478,12 @@ void ScummEngine::executeScript() {
 		_opcode = fetchScriptByte();
 		if (_game.version > 2) // V0-V2 games didn't use the didexec flag
 			vm.slot[_currentScript].didexec = true;
-		debugC(DEBUG_OPCODES, "Script %d, offset 0x%x: [%X] %s()",
-				vm.slot[_currentScript].number,
-				(uint)(_scriptPointer - _scriptOrgPointer),
-				_opcode,
-				getOpcodeDesc(_opcode));
+		if (traceOpcodes)
+			debugC(DEBUG_OPCODES, "Script %d, offset 0x%x: [%X] %s()",
+					vm.slot[_currentScript].number,
+					(uint)(_scriptPointer - _scriptOrgPointer),
+					_opcode,
+					getOpcodeDesc(_opcode));
 		if (_hexdumpScripts == true) {
 			for (c = -1; c < 15; c++) {
 				debugN(" %02x", *(_scriptPointer + c));
@@ -481,8 +491,20 @@ void ScummEngine::executeScript() {
 			debugN("\n");
 		}
 
-		executeOpcode(_opcode);
+		if (_opcodeProfiler._enabled) {
+			// The opcode may end the script or run other scripts, so
+			// remember what is being executed first.
+			const byte opcode = _opcode;
+			const byte where = vm.slot[_currentScript].where;
+			const uint16 number = vm.slot[_currentScript].number;
+			const uint32 start = _system->getMillis();
+
+			executeOpcode(opcode);
 
+			_opcodeProfiler.add(opcode, where, number, _system->getMillis() - start);
+		} else {
+			executeOpcode(_opcode);
+		}
 	}
 }
 
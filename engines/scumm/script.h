@@ -24,6 +24,7 @@
 #define SCUMM_SCRIPT_H
 
 #include "common/func.h"
+#include "common/hashmap.h"
 
 namespace Scumm {
 
@@ -128,6 +129,46 @@ struct VirtualMachineState {
 	byte numNestedScripts;
 };
 
+/**
+ * Counts how often each opcode and each script is executed and how much
+ * time is spent in them, for the "opcodes" debugger command.
+ *
+ * Time is measured with getMillis(), which is much coarser than a single
+ * opcode. The totals over many executions are still meaningful, since an
+ * opcode is charged for a millisecond exactly when a clock tick falls into
+ * its execution. Times include any scripts run nested from an opcode.
+ */
+class OpcodeProfiler {
+public:
+	struct Entry {
+		uint32 count;
+		uint32 time;
+	};
+
+	typedef Common::HashMap<uint32, Entry> ScriptMap;
+
+	OpcodeProfiler() : _enabled(false) { reset(); }
+
+	void reset();
+
+	void add(byte opcode, byte where, uint16 script, uint32 time) {
+		_opcodes[opcode].count++;
+		_opcodes[opcode].time += time;
+
+		Entry &e = _scripts[makeScriptKey(where, script)];
+		e.count++;
+		e.time += time;
+	}
+
+	static uint32 makeScriptKey(byte where, uint16 script) { return (where << 16) | script; }
+	static byte getScriptWhere(uint32 key) { return key >> 16; }
+	static uint16 getScriptNumber(uint32 key) { return key & 0xFFFF; }
+
+	bool _enabled;
+	Entry _opcodes[256];
+	ScriptMap _scripts;		///< keyed by makeScriptKey()
+};
+
 } // End of namespace Scumm
 
 #endif
@@ -265,6 +265,9 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_snapScroll = false;
 	_shakeEnabled = false;
 	_shakeFrame = 0;
+	_screenUploads = 0;
+	_screenUploadPixels = 0;
+	memset(&_screenStats, 0, sizeof(_screenStats));
 	_screenStartStrip = 0;
 	_screenEndStrip = 0;
 	_screenTop = 0;
@@ -314,6 +317,7 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_keepText = false;
 	_costumeLoader = NULL;
 	_costumeRenderer = NULL;
+	_costumeCelCache = NULL;
 	_2byteFontPtr = 0;
 	_V1TalkingActor = 0;
 	_NESStartStrip = 0;
@@ -604,6 +608,8 @@ ScummEngine::~ScummEngine() {
 
 	delete _costumeLoader;
 	delete _costumeRenderer;
+	delete _costumeCelCache;
+	_costumeCelCache = NULL;	// checked when _res frees the costumes below
 
 	_textSurface.free();
 
@@ -1393,6 +1399,7 @@ void ScummEngine::setupCostumeRenderer() {
 		_costumeRenderer = new ClassicCostumeRenderer(this);
 		_costumeLoader = new ClassicCostumeLoader(this);
 	}
+	_costumeCelCache = new CostumeCelCache();
 }
 
 void ScummEngine::resetScumm() {
@@ -2371,6 +2378,12 @@ void ScummEngine_v90he::scummLoop_handleDrawing() {
 		_sprite->sortActiveSprites();
 	}
 }
+
+void ScummEngine_v90he::drawDirtyScreenParts() {
+	ScummEngine_v80he::drawDirtyScreenParts();
+
+	_sprite->drawRedrawRects();
+}
 #endif
 
 void ScummEngine_v6::scummLoop_handleActors() {
@@ -2412,6 +2425,7 @@ void ScummEngine_v7::scummLoop_handleSound() {
 	ScummEngine_v6::scummLoop_handleSound();
 	if (_imuseDigital) {
 		_imuseDigital->flushTracks();
+		_imuseDigital->readAheadTracks();
 		// In CoMI and the Dig the full (non-demo) version invoke IMuseDigital::refreshScripts
 		if ((_game.id == GID_DIG || _game.id == GID_CMI) && !(_game.features & GF_DEMO))
 			_imuseDigital->refreshScripts();
@@ -80,6 +80,7 @@ namespace Scumm {
 class Actor;
 class BaseCostumeLoader;
 class BaseCostumeRenderer;
+class CostumeCelCache;
 class BaseScummFile;
 class CharsetRenderer;
 class IMuse;
@@ -156,6 +157,9 @@ enum GameFeatures {
 /* SCUMM Debug Channels */
 void debugC(int level, const char *s, ...) GCC_PRINTF(2, 3);
 
+/** Returns whether debugC() prints messages of the given channel. */
+bool isDebugChannelActive(int channel);
+
 enum {
 	DEBUG_GENERAL	=	1 << 0,		// General debug
 	DEBUG_SCRIPTS	=	1 << 2,		// Track script execution (start/stop/pause)
@@ -533,6 +537,7 @@ public:
 
 	BaseCostumeLoader *_costumeLoader;
 	BaseCostumeRenderer *_costumeRenderer;
+	CostumeCelCache *_costumeCelCache;
 
 	int _NESCostumeSet;
 	void NES_loadCostumeSet(int n);
@@ -635,6 +640,7 @@ protected:
 	int _vmStack[150];
 
 	OpcodeEntry _opcodes[256];
+	OpcodeProfiler _opcodeProfiler;
 
 	virtual void setupOpcodes() = 0;
 	void executeOpcode(byte i);
@@ -1020,6 +1026,19 @@ protected:
 	byte *_compositeBuf;
 	byte *_herculesBuf;
 
+	// Number of copyRectToScreen() calls and pixels uploaded in this frame
+	uint32 _screenUploads;
+	uint32 _screenUploadPixels;
+
+	struct ScreenStats {
+		uint32 frames;
+		uint32 uploads;		///< total copyRectToScreen() calls
+		uint32 pixels;		///< total pixels uploaded
+		uint32 maxUploads;	///< most copyRectToScreen() calls in a frame
+		uint32 lastUploads;
+		uint32 lastPixels;
+	} _screenStats;
+
 	virtual void drawDirtyScreenParts();
 	void updateDirtyScreen(VirtScreenNumber slot);
 	void drawStripToScreen(VirtScreen *vs, int x, int w, int t, int b);
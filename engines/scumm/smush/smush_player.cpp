@@ -241,6 +241,13 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_paused = false;
 	_pauseStartTime = 0;
 	_pauseTime = 0;
+
+	for (int i = 0; i < kDecodeAheadFrames; i++) {
+		_decodedFrames[i].pixels = NULL;
+		_decodedFrames[i].pixelsSize = 0;
+	}
+	_decodedFirst = 0;
+	_decodedCount = 0;
 }
 
 SmushPlayer::~SmushPlayer() {
@@ -296,6 +303,14 @@ void SmushPlayer::release() {
 	free(_frameBuffer);
 	_frameBuffer = NULL;
 
+	for (int i = 0; i < kDecodeAheadFrames; i++) {
+		free(_decodedFrames[i].pixels);
+		_decodedFrames[i].pixels = NULL;
+		_decodedFrames[i].pixelsSize = 0;
+	}
+	_decodedFirst = 0;
+	_decodedCount = 0;
+
 	_IACTstream = NULL;
 
 	_vm->_smushActive = false;
@@ -1019,7 +1034,6 @@ void SmushPlayer::parseNextFrame() {
 	const int32 subOffset = _base->pos();
 
 	if (_base->pos() >= (int32)_baseSize) {
-		_vm->_smushVideoShouldFinish = true;
 		_endOfFile = true;
 		return;
 	}
@@ -1045,6 +1059,71 @@ void SmushPlayer::parseNextFrame() {
 	_vm->_imuseDigital->flushTracks();
 }
 
+void SmushPlayer::decodeNextFrame() {
+	DecodedFrame &f = _decodedFrames[(_decodedFirst + _decodedCount) % kDecodeAheadFrames];
+	f.dueTime = ((_frame - _startFrame) * 1000) / _speed;
+
+	timerCallback();
+
+	f.updateNeeded = _updateNeeded;
+	if (_updateNeeded) {
+		// Workaround for bug #1386333: "FT DEMO: assertion triggered
+		// when playing movie". Some frames there are 384 x 224
+		f.width = MIN(_width, _vm->_screenWidth);
+		f.height = MIN(_height, _vm->_screenHeight);
+
+		if (f.pixelsSize < f.width * f.height) {
+			free(f.pixels);
+			f.pixelsSize = f.width * f.height;
+			f.pixels = (byte *)malloc(f.pixelsSize);
+			assert(f.pixels);
+		}
+		for (int y = 0; y < f.height; y++)
+			memcpy(f.pixels + y * f.width, _dst + y * _width, f.width);
+		_updateNeeded = false;
+	}
+
+	f.palDirtyMin = _palDirtyMin;
+	f.palDirtyMax = _palDirtyMax;
+	if (_palDirtyMax >= _palDirtyMin) {
+		memcpy(f.pal, _pal, sizeof(f.pal));
+		_palDirtyMax = -1;
+		_palDirtyMin = 256;
+	}
+
+	_decodedCount++;
+}
+
+void SmushPlayer::showDueFrames(uint32 elapsed) {
+	int due = 0, shown = -1;
+	while (due < _decodedCount) {
+		const DecodedFrame &f = _decodedFrames[(_decodedFirst + due) % kDecodeAheadFrames];
+		if (elapsed < f.dueTime)
+			break;
+		if (f.updateNeeded)
+			shown = due;
+		due++;
+	}
+
+	// The palette changes of all due frames have to be applied, but when
+	// we are running late only the most recent picture is shown.
+	for (int i = 0; i < due; i++) {
+		const DecodedFrame &f = _decodedFrames[(_decodedFirst + i) % kDecodeAheadFrames];
+		if (f.palDirtyMax >= f.palDirtyMin)
+			_vm->_system->getPaletteManager()->setPalette(f.pal + f.palDirtyMin * 3, f.palDirtyMin, f.palDirtyMax - f.palDirtyMin + 1);
+
+		if (i == shown) {
+			_vm->_system->copyRectToScreen(f.pixels, f.width, 0, 0, f.width, f.height);
+			_vm->_system->updateScreen();
+		} else if (f.updateNeeded) {
+			debugC(DEBUG_SMUSH, "SmushPlayer::showDueFrames() Dropping late frame");
+		}
+	}
+
+	_decodedFirst = (_decodedFirst + due) % kDecodeAheadFrames;
+	_decodedCount -= due;
+}
+
 void SmushPlayer::setPalette(const byte *palette) {
 	memcpy(_pal, palette, 0x300);
 	setDirtyColors(0, 255);
@@ -1173,11 +1252,11 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 
 	_pauseTime = 0;
 
-	int skipped = 0;
+	_decodedFirst = 0;
+	_decodedCount = 0;
 
 	for (;;) {
 		uint32 now, elapsed;
-		bool skipFrame = false;
 
 		if (_insanity) {
 			// Seeking makes a mess of trying to sync the audio to
@@ -1198,12 +1277,16 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 			elapsed = now - _startTime;
 		}
 
-		if (elapsed >= ((_frame - _startFrame) * 1000) / _speed) {
-			if (elapsed >= ((_frame + 1) * 1000) / _speed)
-				skipFrame = true;
-			else
-				skipFrame = false;
-			timerCallback();
+		// Frames are decoded ahead of time, so that the time spent waiting
+		// for earlier frames absorbs the cost of expensive ones. INSANE
+		// reacts to input between frames and seeks around in the file, so
+		// there each frame is still decoded only once it is due.
+		bool decoded = false;
+		if (!_endOfFile && _decodedCount < (_insanity ? 1 : (int)kDecodeAheadFrames)) {
+			if (!_insanity || elapsed >= ((_frame - _startFrame) * 1000) / _speed) {
+				decodeNextFrame();
+				decoded = true;
+			}
 		}
 
 		_vm->scummLoop_handleSound();
@@ -1214,33 +1297,8 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 		}
 		_vm->parseEvents();
 		_vm->processInput();
-		if (_palDirtyMax >= _palDirtyMin) {
-			_vm->_system->getPaletteManager()->setPalette(_pal + _palDirtyMin * 3, _palDirtyMin, _palDirtyMax - _palDirtyMin + 1);
-
-			_palDirtyMax = -1;
-			_palDirtyMin = 256;
-			skipFrame = false;
-		}
-		if (skipFrame) {
-			if (++skipped > 10) {
-				skipFrame = false;
-				skipped = 0;
-			}
-		} else
-			skipped = 0;
-		if (_updateNeeded) {
-			if (!skipFrame) {
-				// Workaround for bug #1386333: "FT DEMO: assertion triggered
-				// when playing movie". Some frames there are 384 x 224
-				int w = MIN(_width, _vm->_screenWidth);
-				int h = MIN(_height, _vm->_screenHeight);
-
-				_vm->_system->copyRectToScreen(_dst, _width, 0, 0, w, h);
-				_vm->_system->updateScreen();
-				_updateNeeded = false;
-			}
-		}
-		if (_endOfFile)
+		showDueFrames(elapsed);
+		if (_endOfFile && _decodedCount == 0)
 			break;
 		if (_vm->shouldQuit() || _vm->_saveLoadFlag || _vm->_smushVideoShouldFinish) {
 			_smixer->stop();
@@ -1249,7 +1307,8 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 			_IACTpos = 0;
 			break;
 		}
-		_vm->_system->delayMillis(10);
+		if (!decoded || _insanity)
+			_vm->_system->delayMillis(10);
 	}
 
 	release();
@@ -38,6 +38,21 @@ class Codec47Decoder;
 class SmushPlayer {
 	friend class Insane;
 private:
+	enum {
+		kDecodeAheadFrames = 4
+	};
+
+	/** A decoded frame waiting to be shown, see play(). */
+	struct DecodedFrame {
+		uint32 dueTime;
+		bool updateNeeded;
+		byte *pixels;
+		int pixelsSize;
+		int width, height;
+		int palDirtyMin, palDirtyMax;
+		byte pal[0x300];
+	};
+
 	ScummEngine_v7 *_vm;
 	int32 _nbframes;
 	SmushMixer *_smixer;
@@ -82,6 +97,9 @@ private:
 	bool _middleAudio;
 	bool _skipPalette;
 
+	DecodedFrame _decodedFrames[kDecodeAheadFrames];
+	int _decodedFirst, _decodedCount;
+
 public:
 	SmushPlayer(ScummEngine_v7 *scumm);
 	~SmushPlayer();
@@ -111,6 +129,8 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void decodeNextFrame();
+	void showDueFrames(uint32 elapsed);
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
@@ -20,15 +20,270 @@
  *
  */
 
+#include "common/algorithm.h"
+#include "common/archive.h"
+#include "common/file.h"
+#include "common/system.h"
+
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/resmanager.h"
+#include "sword25/kernel/resource.h"
+#include "sword25/gfx/graphicengine.h"
+#include "sword25/gfx/renderobjectmanager.h"
+#include "sword25/gfx/image/vectorimage.h"
+#include "sword25/package/packagemanager.h"
+#include "sword25/script/luascript.h"
+#include "sword25/util/lua/lua.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
+	DCmd_Register("framestats", WRAP_METHOD(Sword25Console, Cmd_FrameStats));
+	DCmd_Register("resources",  WRAP_METHOD(Sword25Console, Cmd_Resources));
+	DCmd_Register("vectorbench", WRAP_METHOD(Sword25Console, Cmd_VectorBench));
+	DCmd_Register("luaprof",    WRAP_METHOD(Sword25Console, Cmd_LuaProfile));
+	DCmd_Register("luagc",      WRAP_METHOD(Sword25Console, Cmd_LuaGC));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_FrameStats(int argc, const char **argv) {
+	GraphicEngine *gfx = Kernel::getInstance()->getGfx();
+	if (!gfx || !gfx->getRenderObjectManager()) {
+		DebugPrintf("The graphics engine is not running\n");
+		return true;
+	}
+
+	RenderObjectManager *manager = gfx->getRenderObjectManager();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			manager->_stats.reset();
+			DebugPrintf("Frame statistics reset\n");
+		} else {
+			DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const RenderObjectManager::FrameStats &last = manager->_lastFrameStats;
+	const RenderObjectManager::FrameStats &all = manager->_stats;
+
+	DebugPrintf("Last frame: %d objects rendered, %d skipped, %d areas, %d pixels redrawn%s\n",
+		last.objectsRendered, last.objectsSkipped, last.dirtyRects, last.dirtyPixels,
+		last.idleFrames ? " (nothing changed)" : (last.fullRefreshes ? " (full refresh)" : ""));
+
+	DebugPrintf("Since reset: %d frames redrawn (%d full), %d unchanged\n",
+		all.frames, all.fullRefreshes, all.idleFrames);
+	if (all.frames) {
+		DebugPrintf("  Per redrawn frame: %d objects rendered, %d skipped, %d areas, %d pixels\n",
+			all.objectsRendered / all.frames, all.objectsSkipped / all.frames,
+			all.dirtyRects / all.frames, all.dirtyPixels / all.frames);
+	}
+
+	return true;
+}
+
+static bool compareResourceSizes(const Resource *a, const Resource *b) {
+	return a->getSize() > b->getSize();
+}
+
+bool Sword25Console::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *resMan = Kernel::getInstance()->getResourceManager();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			resMan->_stats = ResourceManager::Stats();
+			DebugPrintf("Resource statistics reset\n");
+		} else {
+			DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	static const char *const typeNames[] = { "unknown", "bitmap", "animation", "sound", "font" };
+	const uint typeCount = ARRAYSIZE(typeNames);
+	uint count[typeCount], bytes[typeCount];
+	memset(count, 0, sizeof(count));
+	memset(bytes, 0, sizeof(bytes));
+
+	uint lockedCount = 0, lockedBytes = 0;
+	Common::Array<Resource *> resources;
+
+	Common::List<Resource *>::const_iterator iter = resMan->_resources.begin();
+	for (; iter != resMan->_resources.end(); ++iter) {
+		Resource *res = *iter;
+		uint type = res->getType() < typeCount ? res->getType() : 0;
+		count[type]++;
+		bytes[type] += res->getSize();
+		if (res->getLockCount() > 0) {
+			lockedCount++;
+			lockedBytes += res->getSize();
+		}
+		resources.push_back(res);
+	}
+
+	uint used = resMan->getUsedMemory();
+	uint max = resMan->getMaxMemoryUsage();
+	DebugPrintf("%d resources, %d KB of %d KB used (%d%%), %d locked (%d KB)\n",
+		resources.size(), used / 1024, max / 1024, max ? (int)((double)used * 100 / max) : 0,
+		lockedCount, lockedBytes / 1024);
+
+	for (uint i = 0; i < typeCount; ++i) {
+		if (count[i])
+			DebugPrintf("  %-10s %5d resources, %8d KB\n", typeNames[i], count[i], bytes[i] / 1024);
+	}
+
+	const ResourceManager::Stats &stats = resMan->_stats;
+	DebugPrintf("Requests: %d hits, %d misses, %d evictions (%d KB), %d forced unlocks\n",
+		stats.hits, stats.misses, stats.evictions, stats.evictedBytes / 1024, stats.forcedUnlocks);
+
+	Common::sort(resources.begin(), resources.end(), compareResourceSizes);
+	DebugPrintf("Largest resources:\n");
+	for (uint i = 0; i < resources.size() && i < 10; ++i) {
+		DebugPrintf("  %8d KB %s%s\n", resources[i]->getSize() / 1024, resources[i]->getFileName().c_str(),
+			resources[i]->getLockCount() ? " (locked)" : "");
+	}
+
+	return true;
+}
+
+bool Sword25Console::Cmd_VectorBench(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("Usage: %s [<pattern>]\n", argv[0]);
+		DebugPrintf("Renders all matching vector images (default /*.swf) at several scales\n");
+		return true;
+	}
+
+	static const int scales[] = { 50, 100, 200 };	// in percent
+	const int scaleCount = ARRAYSIZE(scales);
+
+	Common::ArchiveMemberList files;
+	Kernel::getInstance()->getPackage()->doSearch(files, argc > 1 ? argv[1] : "/*.swf", "", PackageManager::FT_FILE);
+
+	uint imageCount = 0;
+	uint time[scaleCount];
+	uint pixels[scaleCount];
+	memset(time, 0, sizeof(time));
+	memset(pixels, 0, sizeof(pixels));
+
+	for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it) {
+		Common::SeekableReadStream *stream = (*it)->createReadStream();
+		if (!stream)
+			continue;
+
+		uint fileSize = stream->size();
+		byte *fileData = new byte[fileSize];
+		stream->read(fileData, fileSize);
+		delete stream;
+
+		bool result = false;
+		VectorImage *image = new VectorImage(fileData, fileSize, result, (*it)->getName());
+		delete[] fileData;
+
+		if (result && image->getWidth() > 0 && image->getHeight() > 0) {
+			imageCount++;
+
+			for (int i = 0; i < scaleCount; i++) {
+				int width = MAX(1, image->getWidth() * scales[i] / 100);
+				int height = MAX(1, image->getHeight() * scales[i] / 100);
+
+				uint startTime = g_system->getMillis();
+				free(image->render(width, height));
+				time[i] += g_system->getMillis() - startTime;
+				pixels[i] += width * height;
+			}
+		}
+
+		delete image;
+	}
+
+	DebugPrintf("Rendered %d of %d vector images\n", imageCount, files.size());
+	for (int i = 0; i < scaleCount; i++) {
+		DebugPrintf("  %3d%%: %6d ms, %8d KPixels\n", scales[i], time[i], pixels[i] / 1000);
+	}
+
+	return true;
+}
+
+static bool compareProfileEntries(const LuaProfiler::Entry &a, const LuaProfiler::Entry &b) {
+	return a.selfTime > b.selfTime;
+}
+
+bool Sword25Console::Cmd_LuaProfile(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+	LuaProfiler &profiler = script->getProfiler();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			script->setProfiling(true);
+			DebugPrintf("Lua profiler enabled\n");
+		} else if (!strcmp(argv[1], "off")) {
+			script->setProfiling(false);
+			DebugPrintf("Lua profiler disabled\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			profiler.reset();
+			DebugPrintf("Lua profile reset\n");
+		} else if (!strcmp(argv[1], "dump") && argc > 2) {
+			Common::DumpFile out;
+			if (!out.open(argv[2])) {
+				DebugPrintf("Cannot open '%s' for writing\n", argv[2]);
+				return true;
+			}
+			profiler.dump(out);
+			out.finalize();
+			DebugPrintf("Lua profile written to '%s'\n", argv[2]);
+		} else {
+			DebugPrintf("Usage: %s [on|off|reset|dump <file>]\n", argv[0]);
+		}
+		return true;
+	}
+
+	Common::Array<LuaProfiler::Entry> entries = profiler.getEntries();
+	Common::sort(entries.begin(), entries.end(), compareProfileEntries);
+
+	DebugPrintf("Lua profiler is %s, %d functions seen\n", profiler.isEnabled() ? "on" : "off", entries.size());
+	DebugPrintf("  self ms  total ms     calls  function\n");
+	for (uint i = 0; i < entries.size() && i < 20; ++i) {
+		DebugPrintf("  %7d  %8d  %8d  %s\n", entries[i].selfTime, entries[i].totalTime, entries[i].calls,
+			entries[i].name.c_str());
+	}
+
+	return true;
+}
+
+bool Sword25Console::Cmd_LuaGC(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+
+	if (argc == 3) {
+		int value = atoi(argv[2]);
+		if (!strcmp(argv[1], "pause")) {
+			script->_gcPause = value;
+		} else if (!strcmp(argv[1], "stepmul")) {
+			script->_gcStepMul = value;
+		} else if (!strcmp(argv[1], "stepsize")) {
+			script->_gcStepSize = value;
+		} else if (!strcmp(argv[1], "budget")) {
+			script->_gcFrameBudget = MAX(value, 0);
+		} else {
+			DebugPrintf("Unknown setting '%s'\n", argv[1]);
+			return true;
+		}
+		script->applyGarbageCollectorSettings();
+	} else if (argc != 1) {
+		DebugPrintf("Usage: %s [pause|stepmul|stepsize|budget <value>]\n", argv[0]);
+		return true;
+	}
+
+	DebugPrintf("Lua memory: %d KB\n", script->_state ? lua_gc(script->_state, LUA_GCCOUNT, 0) : 0);
+	DebugPrintf("pause %d%%, stepmul %d%%, stepsize %d KB, budget %d ms per frame\n",
+		script->_gcPause, script->_gcStepMul, script->_gcStepSize, script->_gcFrameBudget);
+	DebugPrintf("%d steps and %d complete cycles between frames\n", script->_gcSteps, script->_gcCycles);
+
+	return true;
+}
+
 } // End of namespace Sword25
@@ -35,6 +35,12 @@ public:
 	virtual ~Sword25Console(void);
 
 private:
+	bool Cmd_FrameStats(int argc, const char **argv);
+	bool Cmd_Resources(int argc, const char **argv);
+	bool Cmd_VectorBench(int argc, const char **argv);
+	bool Cmd_LuaProfile(int argc, const char **argv);
+	bool Cmd_LuaGC(int argc, const char **argv);
+
 	Sword25Engine *_vm;
 };
 
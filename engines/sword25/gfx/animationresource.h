@@ -48,6 +48,10 @@ public:
 	AnimationResource(const Common::String &filename);
 	virtual ~AnimationResource();
 
+	virtual uint getSize() const {
+		return _frames.size() * sizeof(Frame);
+	}
+
 	virtual const Frame &getFrame(uint index) const {
 		return _frames[index];
 	}
@@ -49,6 +49,7 @@
 #include "sword25/gfx/graphicengine.h"
 
 #include "sword25/fmv/movieplayer.h"
+#include "sword25/script/script.h"
 
 #include "sword25/util/lua/lua.h"
 #include "sword25/util/lua/lauxlib.h"
@@ -61,6 +62,8 @@ enum {
 namespace Sword25 {
 
 static const uint FRAMETIME_SAMPLE_COUNT = 5;       // Anzahl der Framezeiten ber die, die Framezeit gemittelt wird
+static const uint FRAME_TIME_TARGET = 16;           // Time in milliseconds a frame should take at most
+static const uint LOAD_QUEUE_TIME = 10;             // Time in milliseconds spent on loading queued resources per frame
 
 GraphicEngine::GraphicEngine(Kernel *pKernel) :
 	_width(0),
@@ -107,6 +110,7 @@ bool GraphicEngine::init(int width, int height, int bitDepth, int backbufferCoun
 	_screenRect.top = 0;
 	_screenRect.right = _width;
 	_screenRect.bottom = _height;
+	_clipRect = _screenRect;
 
 	const Graphics::PixelFormat format = g_system->getScreenFormat();
 
@@ -135,19 +139,34 @@ bool GraphicEngine::startFrame(bool updateAll) {
 	// Den Layer-Manager auf den nchsten Frame vorbereiten
 	_renderObjectManagerPtr->startFrame();
 
+	if (updateAll)
+		_renderObjectManagerPtr->invalidate();
+
 	return true;
 }
 
 bool GraphicEngine::endFrame() {
 #ifndef THEORA_INDIRECT_RENDERING
-	if (Kernel::getInstance()->getFMV()->isMovieLoaded())
+	if (Kernel::getInstance()->getFMV()->isMovieLoaded()) {
+		// The movie is drawn directly to the screen, so everything has to
+		// be redrawn once it is over.
+		_renderObjectManagerPtr->invalidate();
 		return true;
+	}
 #endif
 
 	_renderObjectManagerPtr->render();
 
 	g_system->updateScreen();
 
+	// Use a little time after each frame to load the resources which the
+	// scripts asked to be precached.
+	Kernel::getInstance()->getResourceManager()->processLoadQueue(LOAD_QUEUE_TIME);
+
+	// Let the scripts collect garbage in the time which is left of the frame
+	uint frameTime = Kernel::getInstance()->getMilliTicks() - _lastTimeStamp;
+	Kernel::getInstance()->getScript()->collectGarbage(frameTime < FRAME_TIME_TARGET ? FRAME_TIME_TARGET - frameTime : 0);
+
 	return true;
 }
 
@@ -181,6 +200,9 @@ bool GraphicEngine::fill(const Common::Rect *fillRectPtr, uint color) {
 		rect = *fillRectPtr;
 	}
 
+	// Only touch the area which is currently being redrawn
+	rect.clip(_clipRect);
+
 	if (rect.width() > 0 && rect.height() > 0) {
 		if (ca == 0xff) {
 			_backSurface.fillRect(rect, color);
@@ -145,6 +145,8 @@ public:
 
 	RenderObjectPtr<Panel> getMainPanel();
 
+	RenderObjectManager *getRenderObjectManager() { return _renderObjectManagerPtr.get(); }
+
 	/**
 	 * Specifies the time (in microseconds) since the last frame has passed
 	 */
@@ -232,6 +234,13 @@ public:
 	Graphics::Surface _backSurface;
 	Graphics::Surface *getSurface() { return &_backSurface; }
 
+	/**
+	 * Restricts all drawing to the given area of the frame buffer. This is
+	 * used to redraw only the parts of the screen which have changed.
+	 */
+	void setClipRect(const Common::Rect &rect) { _clipRect = rect; }
+	const Common::Rect &getClipRect() const { return _clipRect; }
+
 	Common::SeekableReadStream *_thumbnail;
 	Common::SeekableReadStream *getThumbnail() { return _thumbnail; }
 
@@ -290,6 +299,7 @@ protected:
 	int _width;
 	int _height;
 	Common::Rect _screenRect;
+	Common::Rect _clipRect;
 	int _bitDepth;
 
 	/**
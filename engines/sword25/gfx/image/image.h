@@ -85,6 +85,13 @@ public:
 	*/
 	virtual GraphicEngine::COLOR_FORMATS getColorFormat() const = 0;
 
+	/**
+	    @brief Returns the memory in bytes used by copies of the image which are kept to speed up drawing.
+	*/
+	virtual uint getCacheSize() const {
+		return 0;
+	}
+
 	//@}
 
 	//@{
@@ -37,6 +37,43 @@
 
 namespace Sword25 {
 
+/**
+ * Convert the pixels of a decoded PNG image into the ARGB format used by the
+ * engine, writing straight into the final buffer. Returns false for source
+ * formats which are not handled here.
+ */
+static bool convertToARGB(const Graphics::Surface &src, const byte *palette, byte *dst) {
+	const Graphics::PixelFormat format = Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	uint32 *out = (uint32 *)dst;
+
+	if (src.format.bytesPerPixel == 1) {
+		uint32 colors[256];
+		for (int i = 0; i < 256; i++)
+			colors[i] = format.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+
+		for (int y = 0; y < src.h; y++) {
+			const byte *in = (const byte *)src.getBasePtr(0, y);
+			for (int x = 0; x < src.w; x++)
+				*out++ = colors[*in++];
+		}
+		return true;
+	}
+
+	if (src.format == Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)) {
+		// RGBA to ARGB is a rotation by 8 bits
+		for (int y = 0; y < src.h; y++) {
+			const uint32 *in = (const uint32 *)src.getBasePtr(0, y);
+			for (int x = 0; x < src.w; x++) {
+				uint32 color = *in++;
+				*out++ = (color >> 8) | (color << 24);
+			}
+		}
+		return true;
+	}
+
+	return false;
+}
+
 bool ImgLoader::decodePNGImage(const byte *fileDataPtr, uint fileSize, byte *&uncompressedDataPtr, int &width, int &height, int &pitch) {
 	Common::MemoryReadStream *fileStr = new Common::MemoryReadStream(fileDataPtr, fileSize, DisposeAfterUse::NO);
 
@@ -45,15 +82,19 @@ bool ImgLoader::decodePNGImage(const byte *fileDataPtr, uint fileSize, byte *&un
 		error("Error while reading PNG image");
 
 	const Graphics::Surface *sourceSurface = png.getSurface();
-	Graphics::Surface *pngSurface = sourceSurface->convertTo(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24), png.getPalette());
 
-	width = pngSurface->w;
-	height = pngSurface->h;
-	uncompressedDataPtr = new byte[pngSurface->pitch * pngSurface->h];
-	memcpy(uncompressedDataPtr, (byte *)pngSurface->pixels, pngSurface->pitch * pngSurface->h);
-	pngSurface->free();
+	width = sourceSurface->w;
+	height = sourceSurface->h;
+	pitch = width * 4;
+	uncompressedDataPtr = new byte[pitch * height];
+
+	if (!convertToARGB(*sourceSurface, png.getPalette(), uncompressedDataPtr)) {
+		Graphics::Surface *pngSurface = sourceSurface->convertTo(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24), png.getPalette());
+		memcpy(uncompressedDataPtr, (byte *)pngSurface->pixels, pngSurface->pitch * pngSurface->h);
+		pngSurface->free();
+		delete pngSurface;
+	}
 
-	delete pngSurface;
 	delete fileStr;
 
 	// Signal success
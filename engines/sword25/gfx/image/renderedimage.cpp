@@ -99,7 +99,8 @@ static byte *readSavegameThumbnail(const Common::String &filename, uint &fileSiz
 RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 	_data(0),
 	_width(0),
-	_height(0) {
+	_height(0),
+	_scaledSurface(0) {
 	result = false;
 
 	PackageManager *pPackage = Kernel::getInstance()->getPackage();
@@ -149,7 +150,8 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 
 RenderedImage::RenderedImage(uint width, uint height, bool &result) :
 	_width(width),
-	_height(height) {
+	_height(height),
+	_scaledSurface(0) {
 
 	_data = new byte[width * height * 4];
 	Common::fill(_data, &_data[width * height * 4], 0);
@@ -162,7 +164,7 @@ RenderedImage::RenderedImage(uint width, uint height, bool &result) :
 	return;
 }
 
-RenderedImage::RenderedImage() : _width(0), _height(0), _data(0) {
+RenderedImage::RenderedImage() : _width(0), _height(0), _data(0), _scaledSurface(0) {
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
 
 	_doCleanup = false;
@@ -173,6 +175,8 @@ RenderedImage::RenderedImage() : _width(0), _height(0), _data(0) {
 // -----------------------------------------------------------------------------
 
 RenderedImage::~RenderedImage() {
+	freeScaledSurface();
+
 	if (_doCleanup)
 		delete[] _data;
 }
@@ -193,6 +197,8 @@ bool RenderedImage::setContent(const byte *pixeldata, uint size, uint offset, ui
 		return false;
 	}
 
+	freeScaledSurface();
+
 	const byte *in = &pixeldata[offset];
 	byte *out = _data;
 
@@ -206,6 +212,8 @@ bool RenderedImage::setContent(const byte *pixeldata, uint size, uint offset, ui
 }
 
 void RenderedImage::replaceContent(byte *pixeldata, int width, int height) {
+	freeScaledSurface();
+
 	_width = width;
 	_height = height;
 	_data = pixeldata;
@@ -219,6 +227,159 @@ uint RenderedImage::getPixel(int x, int y) {
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Blit one line of ARGB pixels, blending them with the target according to
+ * their alpha. Runs of opaque pixels are copied as a whole.
+ */
+static void blitLine(byte *out, const byte *in, int inStep, int width) {
+	int j = 0;
+	while (j < width) {
+		uint32 pix = *(const uint32 *)in;
+		int a = (pix >> 24) & 0xff;
+
+		if (a == 255 && inStep == 4) {
+			int run = 1;
+			while (j + run < width && (((const uint32 *)in)[run] >> 24) == 255)
+				run++;
+			memcpy(out, in, run * 4);
+			in += run * 4;
+			out += run * 4;
+			j += run;
+			continue;
+		}
+
+		if (a == 255) {
+			*(uint32 *)out = pix;
+		} else if (a != 0) {
+			uint32 dst = *(uint32 *)out;
+			int ob = (dst >> 0) & 0xff;
+			int og = (dst >> 8) & 0xff;
+			int or_ = (dst >> 16) & 0xff;
+			ob += (((int)((pix >> 0) & 0xff) - ob) * a) >> 8;
+			og += (((int)((pix >> 8) & 0xff) - og) * a) >> 8;
+			or_ += (((int)((pix >> 16) & 0xff) - or_) * a) >> 8;
+			*(uint32 *)out = (0xff << 24) | (or_ << 16) | (og << 8) | ob;
+		}
+
+		in += inStep;
+		out += 4;
+		j++;
+	}
+}
+
+/**
+ * Blit one line of ARGB pixels, modulating them with the given color (whose
+ * components have already been premultiplied with its alpha) first.
+ */
+static void blitLineModulated(byte *out, const byte *in, int inStep, int width, int ca, int cr, int cg, int cb) {
+	for (int j = 0; j < width; j++) {
+		uint32 pix = *(const uint32 *)in;
+		int b = (pix >> 0) & 0xff;
+		int g = (pix >> 8) & 0xff;
+		int r = (pix >> 16) & 0xff;
+		int a = (pix >> 24) & 0xff;
+		in += inStep;
+
+		if (ca != 255) {
+			a = a * ca >> 8;
+		}
+
+		switch (a) {
+		case 0: // Full transparency
+			out += 4;
+			break;
+		case 255: // Full opacity
+#if defined(SCUMM_LITTLE_ENDIAN)
+			if (cb != 255)
+				*out++ = (b * cb) >> 8;
+			else
+				*out++ = b;
+
+			if (cg != 255)
+				*out++ = (g * cg) >> 8;
+			else
+				*out++ = g;
+
+			if (cr != 255)
+				*out++ = (r * cr) >> 8;
+			else
+				*out++ = r;
+
+			*out++ = a;
+#else
+			*out++ = a;
+
+			if (cr != 255)
+				*out++ = (r * cr) >> 8;
+			else
+				*out++ = r;
+
+			if (cg != 255)
+				*out++ = (g * cg) >> 8;
+			else
+				*out++ = g;
+
+			if (cb != 255)
+				*out++ = (b * cb) >> 8;
+			else
+				*out++ = b;
+#endif
+			break;
+
+		default: // alpha blending
+#if defined(SCUMM_LITTLE_ENDIAN)
+			if (cb == 0)
+				*out = 0;
+			else if (cb != 255)
+				*out += ((b - *out) * a * cb) >> 16;
+			else
+				*out += ((b - *out) * a) >> 8;
+			out++;
+			if (cg == 0)
+				*out = 0;
+			else if (cg != 255)
+				*out += ((g - *out) * a * cg) >> 16;
+			else
+				*out += ((g - *out) * a) >> 8;
+			out++;
+			if (cr == 0)
+				*out = 0;
+			else if (cr != 255)
+				*out += ((r - *out) * a * cr) >> 16;
+			else
+				*out += ((r - *out) * a) >> 8;
+			out++;
+			*out = 255;
+			out++;
+#else
+			*out = 255;
+			out++;
+			if (cr == 0)
+				*out = 0;
+			else if (cr != 255)
+				*out += ((r - *out) * a * cr) >> 16;
+			else
+				*out += ((r - *out) * a) >> 8;
+			out++;
+			if (cg == 0)
+				*out = 0;
+			else if (cg != 255)
+				*out += ((g - *out) * a * cg) >> 16;
+			else
+				*out += ((g - *out) * a) >> 8;
+			out++;
+			if (cb == 0)
+				*out = 0;
+			else if (cb != 255)
+				*out += ((b - *out) * a * cb) >> 16;
+			else
+				*out += ((b - *out) * a) >> 8;
+			out++;
+#endif
+		}
+	}
+}
+
 bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height) {
 	int ca = (color >> 24) & 0xff;
 
@@ -271,173 +432,67 @@ bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRe
 	height = height * 2 / 3;
 #endif
 
-	Graphics::Surface *img;
-	Graphics::Surface *imgScaled = NULL;
-	byte *savedPixels = NULL;
+	// Work on a copy of the surface description, since the clipping below
+	// adjusts it.
+	Graphics::Surface img;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = scale(srcImage, width, height);
-		savedPixels = (byte *)img->pixels;
+		Common::Rect part = pPartRect ? *pPartRect : Common::Rect(_width, _height);
+		img = *getScaledSurface(srcImage, part, width, height);
 	} else {
-		img = &srcImage;
+		img = srcImage;
 	}
 
-	// Handle off-screen clipping
-	if (posY < 0) {
-		img->h = MAX(0, (int)img->h - -posY);
-		img->pixels = (byte *)img->pixels + img->pitch * -posY;
-		posY = 0;
-	}
+	// Clip the target area against the screen and the area currently being
+	// redrawn. The source area is taken from the mirrored side of the image
+	// when flipping.
+	Common::Rect clipRect(_backSurface->w, _backSurface->h);
+	clipRect.clip(Kernel::getInstance()->getGfx()->getClipRect());
 
-	if (posX < 0) {
-		img->w = MAX(0, (int)img->w - -posX);
-		img->pixels = (byte *)img->pixels + (-posX * 4);
-		posX = 0;
-	}
+	Common::Rect dstRect(posX, posY, posX + img.w, posY + img.h);
+	dstRect.clip(clipRect);
+
+	if (!dstRect.isEmpty()) {
+		int srcX = (flipping & Image::FLIP_V) ? posX + img.w - dstRect.right : dstRect.left - posX;
+		int srcY = (flipping & Image::FLIP_H) ? posY + img.h - dstRect.bottom : dstRect.top - posY;
+		img.pixels = img.getBasePtr(srcX, srcY);
+		img.w = dstRect.width();
+		img.h = dstRect.height();
+		posX = dstRect.left;
+		posY = dstRect.top;
 
-	img->w = CLIP((int)img->w, 0, (int)MAX((int)_backSurface->w - posX, 0));
-	img->h = CLIP((int)img->h, 0, (int)MAX((int)_backSurface->h - posY, 0));
 
-	if ((img->w > 0) && (img->h > 0)) {
 		int xp = 0, yp = 0;
 
 		int inStep = 4;
-		int inoStep = img->pitch;
+		int inoStep = img.pitch;
 		if (flipping & Image::FLIP_V) {
 			inStep = -inStep;
-			xp = img->w - 1;
+			xp = img.w - 1;
 		}
 
 		if (flipping & Image::FLIP_H) {
 			inoStep = -inoStep;
-			yp = img->h - 1;
+			yp = img.h - 1;
 		}
 
-		byte *ino = (byte *)img->getBasePtr(xp, yp);
+		byte *ino = (byte *)img.getBasePtr(xp, yp);
 		byte *outo = (byte *)_backSurface->getBasePtr(posX, posY);
-		byte *in, *out;
-
-		for (int i = 0; i < img->h; i++) {
-			out = outo;
-			in = ino;
-			for (int j = 0; j < img->w; j++) {
-				uint32 pix = *(uint32 *)in;
-				int b = (pix >> 0) & 0xff;
-				int g = (pix >> 8) & 0xff;
-				int r = (pix >> 16) & 0xff;
-				int a = (pix >> 24) & 0xff;
-				in += inStep;
-
-				if (ca != 255) {
-					a = a * ca >> 8;
-				}
 
-				switch (a) {
-				case 0: // Full transparency
-					out += 4;
-					break;
-				case 255: // Full opacity
-#if defined(SCUMM_LITTLE_ENDIAN)
-					if (cb != 255)
-						*out++ = (b * cb) >> 8;
-					else
-						*out++ = b;
-
-					if (cg != 255)
-						*out++ = (g * cg) >> 8;
-					else
-						*out++ = g;
-
-					if (cr != 255)
-						*out++ = (r * cr) >> 8;
-					else
-						*out++ = r;
-
-					*out++ = a;
-#else
-					*out++ = a;
-
-					if (cr != 255)
-						*out++ = (r * cr) >> 8;
-					else
-						*out++ = r;
-
-					if (cg != 255)
-						*out++ = (g * cg) >> 8;
-					else
-						*out++ = g;
-
-					if (cb != 255)
-						*out++ = (b * cb) >> 8;
-					else
-						*out++ = b;
-#endif
-					break;
+		// Without color modulation, most pixels are either fully transparent
+		// or opaque and can be skipped or copied as a whole.
+		const bool modulate = (ca != 255 || cr != 255 || cg != 255 || cb != 255);
 
-				default: // alpha blending
-#if defined(SCUMM_LITTLE_ENDIAN)
-					if (cb == 0)
-						*out = 0;
-					else if (cb != 255)
-						*out += ((b - *out) * a * cb) >> 16;
-					else
-						*out += ((b - *out) * a) >> 8;
-					out++;
-					if (cg == 0)
-						*out = 0;
-					else if (cg != 255)
-						*out += ((g - *out) * a * cg) >> 16;
-					else
-						*out += ((g - *out) * a) >> 8;
-					out++;
-					if (cr == 0)
-						*out = 0;
-					else if (cr != 255)
-						*out += ((r - *out) * a * cr) >> 16;
-					else
-						*out += ((r - *out) * a) >> 8;
-					out++;
-					*out = 255;
-					out++;
-#else
-					*out = 255;
-					out++;
-					if (cr == 0)
-						*out = 0;
-					else if (cr != 255)
-						*out += ((r - *out) * a * cr) >> 16;
-					else
-						*out += ((r - *out) * a) >> 8;
-					out++;
-					if (cg == 0)
-						*out = 0;
-					else if (cg != 255)
-						*out += ((g - *out) * a * cg) >> 16;
-					else
-						*out += ((g - *out) * a) >> 8;
-					out++;
-					if (cb == 0)
-						*out = 0;
-					else if (cb != 255)
-						*out += ((b - *out) * a * cb) >> 16;
-					else
-						*out += ((b - *out) * a) >> 8;
-					out++;
-#endif
-				}
-			}
+		for (int i = 0; i < img.h; i++) {
+			if (modulate)
+				blitLineModulated(outo, ino, inStep, img.w, ca, cr, cg, cb);
+			else
+				blitLine(outo, ino, inStep, img.w);
 			outo += _backSurface->pitch;
 			ino += inoStep;
 		}
 
 		g_system->copyRectToScreen((byte *)_backSurface->getBasePtr(posX, posY), _backSurface->pitch, posX, posY,
-			img->w, img->h);
-	}
-
-	if (imgScaled) {
-		imgScaled->pixels = savedPixels;
-		imgScaled->free();
-		delete imgScaled;
+			img.w, img.h);
 	}
 
 	return true;
@@ -467,6 +522,28 @@ void RenderedImage::copyDirectly(int posX, int posY) {
 	g_system->copyRectToScreen(data, _backSurface->pitch, posX, posY, w, h);
 }
 
+/**
+ * Return a copy of the given part of the image scaled to the given size,
+ * reusing the one made last time if it matches.
+ */
+const Graphics::Surface *RenderedImage::getScaledSurface(const Graphics::Surface &srcImage, const Common::Rect &part, int width, int height) {
+	if (_scaledSurface && _scaledPart == part && _scaledSurface->w == width && _scaledSurface->h == height)
+		return _scaledSurface;
+
+	freeScaledSurface();
+	_scaledSurface = scale(srcImage, width, height);
+	_scaledPart = part;
+	return _scaledSurface;
+}
+
+void RenderedImage::freeScaledSurface() {
+	if (_scaledSurface) {
+		_scaledSurface->free();
+		delete _scaledSurface;
+		_scaledSurface = 0;
+	}
+}
+
 /**
  * Scales a passed surface, creating a new surface with the result
  * @param srcImage		Source image to scale
@@ -485,10 +562,17 @@ Graphics::Surface *RenderedImage::scale(const Graphics::Surface &srcImage, int x
 		const byte *srcP = (const byte *)srcImage.getBasePtr(0, vertUsage[yp]);
 		byte *destP = (byte *)s->getBasePtr(0, yp);
 
-		for (int xp = 0; xp < xSize; ++xp) {
-			const byte *tempSrcP = srcP + (horizUsage[xp] * srcImage.format.bytesPerPixel);
-			for (int byteCtr = 0; byteCtr < srcImage.format.bytesPerPixel; ++byteCtr) {
-				*destP++ = *tempSrcP++;
+		if (srcImage.format.bytesPerPixel == 4) {
+			for (int xp = 0; xp < xSize; ++xp) {
+				*(uint32 *)destP = *(const uint32 *)(srcP + horizUsage[xp] * 4);
+				destP += 4;
+			}
+		} else {
+			for (int xp = 0; xp < xSize; ++xp) {
+				const byte *tempSrcP = srcP + (horizUsage[xp] * srcImage.format.bytesPerPixel);
+				for (int byteCtr = 0; byteCtr < srcImage.format.bytesPerPixel; ++byteCtr) {
+					*destP++ = *tempSrcP++;
+				}
 			}
 		}
 	}
@@ -103,6 +103,10 @@ public:
 		return true;
 	}
 
+	virtual uint getCacheSize() const {
+		return _scaledSurface ? _scaledSurface->pitch * _scaledSurface->h : 0;
+	}
+
 	static Graphics::Surface *scale(const Graphics::Surface &srcImage, int xSize, int ySize);
 
 private:
@@ -113,6 +117,17 @@ private:
 
 	Graphics::Surface *_backSurface;
 
+	/**
+	 * The scaled copy of the image (or of a part of it) made by the last blit
+	 * which needed one. Images are usually drawn at the same size in every
+	 * frame, so this saves scaling them over and over again.
+	 */
+	Graphics::Surface *_scaledSurface;
+	Common::Rect _scaledPart;
+
+	const Graphics::Surface *getScaledSurface(const Graphics::Surface &srcImage, const Common::Rect &part, int width, int height);
+	void freeScaledSurface();
+
 	static int *scaleLine(int size, int srcSize);
 };
 
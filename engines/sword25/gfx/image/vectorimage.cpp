@@ -214,7 +214,7 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _fname(fname) {
 	success = false;
 
 	// Create bitstream object
@@ -299,8 +299,8 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	if (_pixelData)
-		free(_pixelData);
+	for (uint i = 0; i < _renderCache.size(); i++)
+		free(_renderCache[i].pixelData);
 }
 
 
@@ -598,31 +598,52 @@ bool VectorImage::setContent(const byte *pixeldata, uint size, uint offset, uint
 	return 0;
 }
 
+uint VectorImage::getCacheSize() const {
+	uint size = 0;
+	for (uint i = 0; i < _renderCache.size(); i++)
+		size += _renderCache[i].width * _renderCache[i].height * 4;
+	return size;
+}
+
 bool VectorImage::blit(int posX, int posY,
                        int flipping,
                        Common::Rect *pPartRect,
                        uint color,
                        int width, int height) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
+	if (width == -1)
+		width = getWidth();
+	if (height == -1)
+		height = getHeight();
 
 	// If width or height to 0, nothing needs to be shown.
-	if (width == 0 || height == 0)
+	if (width <= 0 || height <= 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
-
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
+	// Look for a rasterized version at this size. If there is none, render
+	// one and make room for it in the cache.
+	CachedRender entry;
+	uint i = 0;
+	while (i < _renderCache.size() && (_renderCache[i].width != width || _renderCache[i].height != height))
+		i++;
+
+	if (i < _renderCache.size()) {
+		entry = _renderCache.remove_at(i);
+	} else {
+		entry.width = width;
+		entry.height = height;
+		entry.pixelData = render(width, height);
+
+		if (_renderCache.size() >= kMaxCachedRenders) {
+			free(_renderCache.back().pixelData);
+			_renderCache.pop_back();
+		}
 	}
 
+	_renderCache.insert_at(0, entry);
+
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(entry.pixelData, width, height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height);
 
 	delete rend;
@@ -181,9 +181,14 @@ public:
 	virtual GraphicEngine::COLOR_FORMATS getColorFormat() const {
 		return GraphicEngine::CF_ARGB32;
 	}
+	virtual uint getCacheSize() const;
 	virtual bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0));
 
-	void render(int width, int height);
+	/**
+	 * Rasterizes the image at the given size into a newly allocated ARGB
+	 * buffer, which has to be freed by the caller.
+	 */
+	byte *render(int width, int height);
 
 	virtual uint getPixel(int x, int y);
 	virtual bool isBlitSource() const {
@@ -224,7 +229,18 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
+	enum {
+		kMaxCachedRenders = 3
+	};
+
+	struct CachedRender {
+		int width;
+		int height;
+		byte *pixelData;
+	};
+
+	/** Rasterized versions of the image, the most recently used first */
+	Common::Array<CachedRender> _renderCache;
 
 	Common::String _fname;
 };
@@ -96,6 +96,10 @@ RenderObject::RenderObject(RenderObjectPtr<RenderObject> parentPtr, TYPES type,
 }
 
 RenderObject::~RenderObject() {
+	// Have the area last covered by the object redrawn
+	if (_managerPtr && _oldVisible)
+		_managerPtr->addDirtyRect(_oldBbox);
+
 	// Objekt aus dem Elternobjekt entfernen.
 	if (_parentPtr.isValid())
 		_parentPtr->detatchChildren(this->getHandle());
@@ -120,8 +124,9 @@ bool RenderObject::render() {
 		_childChanged = false;
 	}
 
-	// Objekt zeichnen.
-	doRender();
+	// Draw the object, unless it lies outside of the area being redrawn
+	if (_managerPtr->isInUpdateRect(_bbox))
+		doRender();
 
 	// Dann mssen die Kinder gezeichnet werden
 	RENDEROBJECT_ITER it = _children.begin();
@@ -156,7 +161,11 @@ bool RenderObject::updateObjectState() {
 			_parentPtr->signalChildChange();
 
 		// Die Bounding-Box neu berechnen und Update-Regions registrieren.
+		if (_managerPtr && _oldVisible)
+			_managerPtr->addDirtyRect(_oldBbox);
 		updateBoxes();
+		if (_managerPtr && _visible)
+			_managerPtr->addDirtyRect(_bbox);
 
 		// nderungen Validieren
 		validateObject();
@@ -44,7 +44,10 @@
 namespace Sword25 {
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
-	_frameStarted(false) {
+	_frameStarted(false),
+	_fullRefresh(true),
+	_screenRect(width, height),
+	_updateRect(width, height) {
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
 	_rootPtr = (new RootRenderObject(this, width, height))->getHandle();
 }
@@ -75,8 +78,105 @@ bool RenderObjectManager::render() {
 
 	_frameStarted = false;
 
-	// Die Render-Methode der Wurzel aufrufen. Dadurch wird das rekursive Rendern der Baumelemente angestoen.
-	return _rootPtr->render();
+	_lastFrameStats.reset();
+
+	if (_fullRefresh) {
+		_dirtyRects.clear();
+		_dirtyRects.push_back(_screenRect);
+		_fullRefresh = false;
+		_lastFrameStats.fullRefreshes = 1;
+	}
+
+	// Nothing has changed, so the screen is still up to date
+	if (_dirtyRects.empty()) {
+		_lastFrameStats.idleFrames = 1;
+		_stats.idleFrames++;
+		return true;
+	}
+
+	_lastFrameStats.frames = 1;
+
+	// Redraw the tree once for every changed area. Drawing is clipped to
+	// the area, and objects outside of it are skipped.
+	GraphicEngine *gfx = Kernel::getInstance()->getGfx();
+	bool result = true;
+	for (uint i = 0; i < _dirtyRects.size() && result; ++i) {
+		_updateRect = _dirtyRects[i];
+		gfx->setClipRect(_updateRect);
+
+		// Die Render-Methode der Wurzel aufrufen. Dadurch wird das rekursive Rendern der Baumelemente angestoen.
+		result = _rootPtr->render();
+
+		_lastFrameStats.dirtyRects++;
+		_lastFrameStats.dirtyPixels += _updateRect.width() * _updateRect.height();
+	}
+
+	_updateRect = _screenRect;
+	gfx->setClipRect(_screenRect);
+	_dirtyRects.clear();
+
+	_stats.frames++;
+	_stats.fullRefreshes += _lastFrameStats.fullRefreshes;
+	_stats.objectsRendered += _lastFrameStats.objectsRendered;
+	_stats.objectsSkipped += _lastFrameStats.objectsSkipped;
+	_stats.dirtyRects += _lastFrameStats.dirtyRects;
+	_stats.dirtyPixels += _lastFrameStats.dirtyPixels;
+
+	return result;
+}
+
+void RenderObjectManager::addDirtyRect(const Common::Rect &rect) {
+	if (_fullRefresh || rect.isEmpty())
+		return;
+
+	Common::Rect r(rect);
+	r.clip(_screenRect);
+	if (r.isEmpty())
+		return;
+
+	// Merge overlapping areas, so that nothing is drawn twice
+	for (uint i = 0; i < _dirtyRects.size();) {
+		if (_dirtyRects[i].intersects(r)) {
+			r.extend(_dirtyRects[i]);
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyRects.size() >= kMaxDirtyRects) {
+		// Too many areas, so merge with the one which grows the least
+		uint best = 0;
+		int bestGrowth = 0;
+		for (uint i = 0; i < _dirtyRects.size(); ++i) {
+			Common::Rect merged(_dirtyRects[i]);
+			merged.extend(r);
+			int growth = merged.width() * merged.height() - _dirtyRects[i].width() * _dirtyRects[i].height();
+			if (i == 0 || growth < bestGrowth) {
+				best = i;
+				bestGrowth = growth;
+			}
+		}
+
+		r.extend(_dirtyRects[best]);
+		_dirtyRects.remove_at(best);
+		addDirtyRect(r);
+		return;
+	}
+
+	_dirtyRects.push_back(r);
+}
+
+bool RenderObjectManager::isInUpdateRect(const Common::Rect &bbox) {
+	// Objects without a proper bounding box are always drawn
+	if (bbox.isEmpty() || bbox.intersects(_updateRect)) {
+		_lastFrameStats.objectsRendered++;
+		return true;
+	}
+
+	_lastFrameStats.objectsSkipped++;
+	return false;
 }
 
 void RenderObjectManager::attatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> renderObjectPtr) {
@@ -140,6 +240,9 @@ bool RenderObjectManager::unpersist(InputPersistenceBlock &reader) {
 	// Alle BS_AnimationTemplates wieder herstellen.
 	result &= AnimationTemplateRegistry::instance().unpersist(reader);
 
+	// Der gesamte Bildschirm muss neu gezeichnet werden.
+	invalidate();
+
 	return result;
 }
 
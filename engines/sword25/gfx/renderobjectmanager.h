@@ -42,6 +42,7 @@
 #ifndef SWORD25_RENDEROBJECTMANAGER_H
 #define SWORD25_RENDEROBJECTMANAGER_H
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/renderobjectptr.h"
@@ -106,11 +107,55 @@ public:
 	*/
 	void detatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> pRenderObject);
 
+	/**
+	    @brief Marks an area of the screen as changed, so that it is redrawn on the next call to render().
+	*/
+	void addDirtyRect(const Common::Rect &rect);
+	/**
+	    @brief Forces the whole screen to be redrawn on the next call to render().
+	*/
+	void invalidate() {
+		_fullRefresh = true;
+	}
+	/**
+	    @brief Checks whether an object with the given bounding box has to be drawn in the area currently being redrawn.
+	*/
+	bool isInUpdateRect(const Common::Rect &bbox);
+
+	struct FrameStats {
+		uint frames;            ///< Frames which redrew anything
+		uint idleFrames;        ///< Frames in which nothing changed
+		uint fullRefreshes;     ///< Frames which redrew the whole screen
+		uint objectsRendered;   ///< Objects drawn
+		uint objectsSkipped;    ///< Objects outside of the changed areas
+		uint dirtyRects;        ///< Changed areas redrawn
+		uint dirtyPixels;       ///< Pixels redrawn
+
+		FrameStats() { reset(); }
+		void reset() {
+			frames = idleFrames = fullRefreshes = 0;
+			objectsRendered = objectsSkipped = dirtyRects = dirtyPixels = 0;
+		}
+	};
+
+	/** Statistics over all frames since the last reset, and for the last frame alone */
+	FrameStats _stats;
+	FrameStats _lastFrameStats;
+
 	virtual bool persist(OutputPersistenceBlock &writer);
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
 private:
+	enum {
+		kMaxDirtyRects = 16
+	};
+
 	bool _frameStarted;
+	bool _fullRefresh;
+	Common::Rect _screenRect;
+	Common::Rect _updateRect;
+	Common::Array<Common::Rect> _dirtyRects;
+
 	typedef Common::Array<RenderObjectPtr<TimedRenderObject> > RenderObjectList;
 	RenderObjectList _timedRenderObjects;
 
@@ -31,14 +31,16 @@
 
 #include "sword25/kernel/outputpersistenceblock.h"
 
-namespace {
-const uint INITIAL_BUFFER_SIZE = 1024 * 64;
-}
-
 namespace Sword25 {
 
-OutputPersistenceBlock::OutputPersistenceBlock() {
-	_data.reserve(INITIAL_BUFFER_SIZE);
+OutputPersistenceBlock::OutputPersistenceBlock() :
+	_size(0),
+	_byteArraySizePos(0) {
+}
+
+OutputPersistenceBlock::~OutputPersistenceBlock() {
+	for (uint i = 0; i < _chunks.size(); ++i)
+		delete[] _chunks[i];
 }
 
 void OutputPersistenceBlock::write(signed int value) {
@@ -85,15 +87,56 @@ void OutputPersistenceBlock::writeByteArray(Common::Array<byte> &value) {
 	rawWrite(&value[0], value.size());
 }
 
+void OutputPersistenceBlock::beginByteArray() {
+	writeMarker(BLOCK_MARKER);
+
+	// Leave room for the size, which is filled in by endByteArray()
+	_byteArraySizePos = _size + 1;
+	write((uint)0);
+}
+
+void OutputPersistenceBlock::writeByteArrayData(const void *dataPtr, uint size) {
+	rawWrite(dataPtr, size);
+}
+
+void OutputPersistenceBlock::endByteArray() {
+	uint size = _size - (_byteArraySizePos + 4);
+
+	for (uint i = 0; i < 4; ++i) {
+		uint pos = _byteArraySizePos + i;
+		_chunks[pos / kChunkSize][pos % kChunkSize] = (size >> (i * 8)) & 0xff;
+	}
+}
+
+bool OutputPersistenceBlock::writeTo(Common::WriteStream &stream) const {
+	uint remaining = _size;
+	for (uint i = 0; i < _chunks.size() && remaining > 0; ++i) {
+		uint size = MIN<uint>(remaining, kChunkSize);
+		if (stream.write(_chunks[i], size) != size)
+			return false;
+		remaining -= size;
+	}
+
+	return true;
+}
+
 void OutputPersistenceBlock::writeMarker(byte marker) {
-	_data.push_back(marker);
+	rawWrite(&marker, 1);
 }
 
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
-	if (size > 0) {
-		uint oldSize = _data.size();
-		_data.resize(oldSize + size);
-		memcpy(&_data[oldSize], dataPtr, size);
+	const byte *src = (const byte *)dataPtr;
+
+	while (size > 0) {
+		uint offset = _size % kChunkSize;
+		if (offset == 0 && _size / kChunkSize == _chunks.size())
+			_chunks.push_back(new byte[kChunkSize]);
+
+		uint count = MIN<uint>(size, kChunkSize - offset);
+		memcpy(_chunks[_size / kChunkSize] + offset, src, count);
+		src += count;
+		size -= count;
+		_size += count;
 	}
 }
 
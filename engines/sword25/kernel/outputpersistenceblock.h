@@ -32,6 +32,7 @@
 #ifndef SWORD25_OUTPUTPERSISTENCEBLOCK_H
 #define SWORD25_OUTPUTPERSISTENCEBLOCK_H
 
+#include "common/stream.h"
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/persistenceblock.h"
 
@@ -40,6 +41,7 @@ namespace Sword25 {
 class OutputPersistenceBlock : public PersistenceBlock {
 public:
 	OutputPersistenceBlock();
+	~OutputPersistenceBlock();
 
 	void write(signed int value);
 	void write(uint value);
@@ -48,18 +50,36 @@ public:
 	void writeString(const Common::String &string);
 	void writeByteArray(Common::Array<byte> &value);
 
-	const void *getData() const {
-		return &_data[0];
-	}
+	/**
+	 * Starts a byte array whose size is not known in advance. Its data is
+	 * appended with writeByteArrayData(), and endByteArray() fills in the size.
+	 */
+	void beginByteArray();
+	void writeByteArrayData(const void *dataPtr, uint size);
+	void endByteArray();
+
+	/**
+	 * Writes the collected data to the given stream.
+	 */
+	bool writeTo(Common::WriteStream &stream) const;
+
 	uint getDataSize() const {
-		return _data.size();
+		return _size;
 	}
 
 private:
+	// The data is kept in chunks of a fixed size, so that it never has to
+	// be moved while it grows.
+	enum {
+		kChunkSize = 64 * 1024
+	};
+
 	void writeMarker(byte marker);
 	void rawWrite(const void *dataPtr, size_t size);
 
-	Common::Array<byte> _data;
+	Common::Array<byte *> _chunks;
+	uint _size;
+	uint _byteArraySizePos;
 };
 
 } // End of namespace Sword25
@@ -314,7 +314,7 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	snprintf(sBuffer, 10, "%u", writer.getDataSize());
 	file->writeString(sBuffer);
 	file->writeByte(0);
-	file->write(writer.getData(), writer.getDataSize());
+	writer.writeTo(*file);
 
 	// Get the screenshot
 	Common::SeekableReadStream *thumbnail = Kernel::getInstance()->getGfx()->getThumbnail();
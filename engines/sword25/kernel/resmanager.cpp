@@ -35,17 +35,24 @@
 #include "sword25/kernel/resservice.h"
 #include "sword25/package/packagemanager.h"
 
+#include "common/algorithm.h"
+#include "common/system.h"
+
 namespace Sword25 {
 
-// Sets the amount of resources that are simultaneously loaded.
-// This needs to be a relatively high number, as all the animation
-// frames in each scene are loaded as separate resources.
-// Also, George's walk states are all loaded here (150 files)
-#define SWORD25_RESOURCECACHE_MIN 400
-// The maximum number of loaded resources. If more than these resources
-// are loaded, the resource manager will start purging resources till it
-// hits the minimum limit above
-#define SWORD25_RESOURCECACHE_MAX 500
+// The default amount of memory in bytes which loaded resources may use.
+// This is the value the scripts set via Kernel.SetMaxMemoryUsage().
+#define SWORD25_RESOURCECACHE_MAX_MEMORY 256000000
+// Resources are charged at least this many bytes when deciding which one
+// to release, so that small resources are not kept forever
+#define SWORD25_RESOURCECACHE_MIN_COST 65536
+
+ResourceManager::ResourceManager(Kernel *pKernel) :
+	_kernelPtr(pKernel),
+	_maxMemoryUsage(SWORD25_RESOURCECACHE_MAX_MEMORY),
+	_usedMemory(0),
+	_accessCounter(0) {
+}
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -82,32 +89,66 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
 	return true;
 }
 
+struct EvictionCandidate {
+	Resource *resource;
+	double score;
+};
+
+static bool compareEvictionCandidates(const EvictionCandidate &a, const EvictionCandidate &b) {
+	return a.score > b.score;
+}
+
+/**
+ * Sets the amount of memory in bytes which loaded resources may use.
+ */
+void ResourceManager::setMaxMemoryUsage(uint maxMemoryUsage) {
+	_maxMemoryUsage = maxMemoryUsage;
+	deleteResourcesIfNecessary();
+}
+
 /**
  * Deletes resources as necessary until the specified memory limit is not being exceeded.
  */
 void ResourceManager::deleteResourcesIfNecessary() {
+	updateUsedMemory();
+
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	if (_usedMemory < _maxMemoryUsage || _resources.empty())
 		return;
 
-	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
-	// The list is processed backwards in order to first release those resources that have been
-	// not been accessed for the longest
-	Common::List<Resource *>::iterator iter = _resources.end();
-	do {
-		--iter;
+	// Release resources until the memory usage falls to 80% of the maximum, so that this does not have
+	// to be done again on the next load
+	const uint minMemoryUsage = _maxMemoryUsage / 5 * 4;
 
-		// The resource may be released only if it isn't locked
-		if ((*iter)->getLockCount() == 0)
-			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+	// Resources which have not been accessed for the longest time are released first. Larger resources
+	// are weighted more heavily, as releasing them frees more memory.
+	// The resource may be released only if it isn't locked
+	Common::Array<EvictionCandidate> candidates;
+	Common::List<Resource *>::iterator iter = _resources.begin();
+	for (; iter != _resources.end(); ++iter) {
+		if ((*iter)->getLockCount() == 0) {
+			EvictionCandidate candidate;
+			candidate.resource = *iter;
+			candidate.score = (double)(_accessCounter - (*iter)->_lastAccess) *
+			                  MAX<uint>((*iter)->_size, SWORD25_RESOURCECACHE_MIN_COST);
+			candidates.push_back(candidate);
+		}
+	}
+
+	Common::sort(candidates.begin(), candidates.end(), compareEvictionCandidates);
+
+	for (uint i = 0; i < candidates.size() && _usedMemory >= minMemoryUsage; ++i) {
+		_stats.evictions++;
+		_stats.evictedBytes += candidates[i].resource->_size;
+		deleteResource(candidates[i].resource);
+	}
 
 	// Are we still above the minimum? If yes, then start releasing locked resources
 	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
 	// in the resource lock code, and resources are not unlocked when changing rooms.
 	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
 	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
+	if (_usedMemory < minMemoryUsage || _resources.empty())
 		return;
 
 	iter = _resources.end();
@@ -124,9 +165,21 @@ void ResourceManager::deleteResourcesIfNecessary() {
 			while ((*iter)->getLockCount() > 0)
 				(*iter)->release();
 
+			_stats.forcedUnlocks++;
+			_stats.evictions++;
+			_stats.evictedBytes += (*iter)->_size;
 			iter = deleteResource(*iter);
 		}
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+	} while (iter != _resources.begin() && _usedMemory >= minMemoryUsage);
+}
+
+void ResourceManager::updateUsedMemory() {
+	Common::List<Resource *>::iterator iter = _resources.begin();
+	for (; iter != _resources.end(); ++iter) {
+		const uint size = (*iter)->getSize();
+		_usedMemory = _usedMemory - (*iter)->_size + size;
+		(*iter)->_size = size;
+	}
 }
 
 /**
@@ -172,8 +225,12 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	// Determine whether the resource is already loaded
 	// If the resource is found, it will be placed at the head of the resource list and returned
 	Resource *pResource = getResource(uniqueFileName);
-	if (!pResource)
+	if (pResource) {
+		_stats.hits++;
+	} else {
+		_stats.misses++;
 		pResource = loadResource(uniqueFileName);
+	}
 	if (pResource) {
 		moveToFront(pResource);
 		(pResource)->addReference();
@@ -183,6 +240,46 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	return NULL;
 }
 
+/**
+ * Queues a resource to be loaded later on, a few at a time between frames.
+ * @param FileName      The filename of the resource to be loaded
+ */
+void ResourceManager::queueResource(const Common::String &fileName) {
+	// Get the absolute path to the file
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty() || getResource(uniqueFileName))
+		return;
+
+	Common::List<Common::String>::const_iterator iter = _loadQueue.begin();
+	for (; iter != _loadQueue.end(); ++iter)
+		if (*iter == uniqueFileName)
+			return;
+
+	_loadQueue.push_back(uniqueFileName);
+}
+
+/**
+ * Loads resources from the queue until the given amount of time has passed.
+ * @param MaxMillis     The time in milliseconds which may be spent loading
+ */
+void ResourceManager::processLoadQueue(uint maxMillis) {
+	uint startTime = g_system->getMillis();
+
+	while (!_loadQueue.empty()) {
+		Common::String fileName = _loadQueue.front();
+		_loadQueue.pop_front();
+
+		// The resource may have been requested in the meantime
+		if (getResource(fileName))
+			continue;
+
+		loadResource(fileName);
+
+		if (g_system->getMillis() - startTime >= maxMillis)
+			break;
+	}
+}
+
 #ifdef PRECACHE_RESOURCES
 
 /**
@@ -231,6 +328,7 @@ void ResourceManager::moveToFront(Resource *pResource) {
 	_resources.push_front(pResource);
 	// Reset the resource iterator to the repositioned item
 	pResource->_iterator = _resources.begin();
+	pResource->_lastAccess = ++_accessCounter;
 }
 
 /**
@@ -256,6 +354,11 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			// Add the resource to the front of the list
 			_resources.push_front(pResource);
 			pResource->_iterator = _resources.begin();
+			pResource->_lastAccess = ++_accessCounter;
+
+			// Account for the memory used by the resource
+			pResource->_size = pResource->getSize();
+			_usedMemory += pResource->_size;
 
 			// Also store the resource in the hash table for quick lookup
 			_resourceHashMap[pResource->getFileName()] = pResource;
@@ -296,6 +399,8 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 	// Remove the resource from the hash table
 	_resourceHashMap.erase(pResource->_fileName);
 
+	_usedMemory -= pResource->_size;
+
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
 
@@ -45,9 +45,11 @@ namespace Sword25 {
 class ResourceService;
 class Resource;
 class Kernel;
+class Sword25Console;
 
 class ResourceManager {
 	friend class Kernel;
+	friend class Sword25Console;
 
 public:
 	/**
@@ -66,6 +68,21 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Queues a resource to be loaded later on, a few at a time between frames.
+	 * This allows the scripts to prefetch the resources of a scene without
+	 * stalling the game while they are decoded.
+	 * @param FileName      The filename of the resource to be loaded
+	 */
+	void queueResource(const Common::String &fileName);
+
+	/**
+	 * Loads resources from the queue until the given amount of time has passed.
+	 * At least one resource is loaded per call, if any are queued.
+	 * @param MaxMillis     The time in milliseconds which may be spent loading
+	 */
+	void processLoadQueue(uint maxMillis);
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -88,14 +105,32 @@ public:
 	 */
 	void dumpLockedResources();
 
+	/**
+	 * Sets the amount of memory in bytes which loaded resources may use.
+	 * If it is exceeded, the resources which have not been used for the longest time are released.
+	 */
+	void setMaxMemoryUsage(uint maxMemoryUsage);
+
+	/**
+	 * Returns the amount of memory in bytes which loaded resources may use
+	 */
+	uint getMaxMemoryUsage() const {
+		return _maxMemoryUsage;
+	}
+
+	/**
+	 * Returns the amount of memory in bytes which is used by the loaded resources
+	 */
+	uint getUsedMemory() const {
+		return _usedMemory;
+	}
+
 private:
 	/**
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
-	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
-	{}
+	ResourceManager(Kernel *pKernel);
 	virtual ~ResourceManager();
 
 	/**
@@ -134,11 +169,33 @@ private:
 	 */
 	void deleteResourcesIfNecessary();
 
+	/**
+	 * Accounts for the current memory usage of all loaded resources, which can grow after loading
+	 * (e.g. by images caching rendered copies).
+	 */
+	void updateUsedMemory();
+
+	struct Stats {
+		uint hits;              ///< Requests for resources which were already loaded
+		uint misses;            ///< Requests which had to load the resource
+		uint evictions;         ///< Resources released to stay within the memory limit
+		uint evictedBytes;      ///< Memory freed by these
+		uint forcedUnlocks;     ///< Locked resources which had to be released
+
+		Stats() : hits(0), misses(0), evictions(0), evictedBytes(0), forcedUnlocks(0) {}
+	};
+
 	Kernel *_kernelPtr;
 	Common::Array<ResourceService *> _resourceServices;
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	Common::List<Common::String> _loadQueue;
+
+	uint _maxMemoryUsage;
+	uint _usedMemory;
+	uint _accessCounter;
+	Stats _stats;
 };
 
 } // End of namespace Sword25
@@ -49,6 +49,7 @@ MODULE_OBJS := \
 	package/packagemanager_script.o \
 	script/luabindhelper.o \
 	script/luacallback.o \
+	script/luaprofiler.o \
 	script/luascript.o \
 	script/lua_extensions.o \
 	sfx/soundengine.o \
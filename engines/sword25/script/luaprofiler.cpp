@@ -0,0 +1,246 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/stream.h"
+#include "common/system.h"
+
+#include "sword25/script/luaprofiler.h"
+
+#include "sword25/util/lua/lua.h"
+
+namespace Sword25 {
+
+LuaProfiler::LuaProfiler() : _enabled(false), _lastCallStack(0) {
+}
+
+void LuaProfiler::setEnabled(bool enabled) {
+	_enabled = enabled;
+
+	// Calls which are in progress cannot be accounted for correctly
+	_callStacks.clear();
+	_lastCallStack = 0;
+}
+
+void LuaProfiler::reset() {
+	_entries.clear();
+	_entryMap.clear();
+	_callStacks.clear();
+	_lastCallStack = 0;
+}
+
+LuaProfiler::CallStack &LuaProfiler::getCallStack(lua_State *L) {
+	// Each coroutine has its own call stack. Usually only a few are active,
+	// and the same one is asked for many times in a row.
+	if (_lastCallStack < _callStacks.size() && _callStacks[_lastCallStack].thread == L)
+		return _callStacks[_lastCallStack];
+
+	for (uint i = 0; i < _callStacks.size(); ++i) {
+		if (_callStacks[i].thread == L) {
+			_lastCallStack = i;
+			return _callStacks[i];
+		}
+	}
+
+	registerThread(L);
+
+	CallStack stack;
+	stack.thread = L;
+	_callStacks.push_back(stack);
+	_lastCallStack = _callStacks.size() - 1;
+	return _callStacks.back();
+}
+
+void LuaProfiler::registerThread(lua_State *L) {
+	// Remember the coroutine in a table with weak keys, which tells
+	// removeDeadThreads() when it has been collected. Without it, the call
+	// stack is dropped by the next removeDeadThreads().
+	if (!lua_checkstack(L, 4))
+		return;
+
+	lua_pushlightuserdata(L, this);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_newtable(L);
+		lua_pushstring(L, "__mode");
+		lua_pushstring(L, "k");
+		lua_rawset(L, -3);
+		lua_setmetatable(L, -2);
+
+		lua_pushlightuserdata(L, this);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, LUA_REGISTRYINDEX);
+	}
+
+	lua_pushthread(L);
+	lua_pushboolean(L, 1);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
+}
+
+void LuaProfiler::removeDeadThreads(lua_State *L) {
+	if (_callStacks.empty() || !lua_checkstack(L, 3))
+		return;
+
+	Common::Array<lua_State *> threads;
+	lua_pushlightuserdata(L, this);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+	if (lua_istable(L, -1)) {
+		lua_pushnil(L);
+		while (lua_next(L, -2)) {
+			lua_pop(L, 1);
+			threads.push_back(lua_tothread(L, -1));
+		}
+	}
+	lua_pop(L, 1);
+
+	for (int i = _callStacks.size() - 1; i >= 0; --i) {
+		uint j = 0;
+		while (j < threads.size() && threads[j] != _callStacks[i].thread)
+			j++;
+		if (j == threads.size())
+			_callStacks.remove_at(i);
+	}
+	_lastCallStack = 0;
+}
+
+/**
+ * Returns the number of levels on the Lua stack of the given thread.
+ */
+static int getStackDepth(lua_State *L) {
+	// lua_getstack() walks down the given number of levels, so search for
+	// the first missing level instead of trying them all in turn. Level 0
+	// is the function the hook was called for.
+	lua_Debug ar;
+	int found = 0;
+	int missing = 1;
+	while (lua_getstack(L, missing, &ar)) {
+		found = missing;
+		missing *= 2;
+	}
+	while (missing - found > 1) {
+		int level = (found + missing) / 2;
+		if (lua_getstack(L, level, &ar))
+			found = level;
+		else
+			missing = level;
+	}
+	return missing;
+}
+
+void LuaProfiler::closeFrames(CallStack &stack, int depth, uint now) {
+	while (!stack.frames.empty() && stack.frames.back().depth >= depth) {
+		Frame frame = stack.frames.back();
+		stack.frames.pop_back();
+
+		uint elapsed = now - frame.startTime;
+		Entry &entry = _entries[frame.entry];
+		entry.totalTime += elapsed;
+		entry.selfTime += elapsed - MIN(elapsed, frame.childTime);
+
+		if (!stack.frames.empty())
+			stack.frames.back().childTime += elapsed;
+	}
+}
+
+bool LuaProfiler::getEntry(lua_State *L, lua_Debug *ar, uint &index) {
+	if (!lua_getinfo(L, "Sn", ar))
+		return false;
+
+	// C functions are told apart by the name they were called by, Lua
+	// functions by where they are defined
+	Common::String key;
+	Common::String name = ar->name ? ar->name : "?";
+	if (!strcmp(ar->what, "C")) {
+		key = "[C] " + name;
+		name = key;
+	} else {
+		key = Common::String::format("%s:%d", ar->short_src, ar->linedefined);
+		name = Common::String::format("%s (%s)", name.c_str(), key.c_str());
+	}
+
+	Common::HashMap<Common::String, uint>::const_iterator it = _entryMap.find(key);
+	if (it != _entryMap.end()) {
+		index = it->_value;
+		return true;
+	}
+
+	Entry entry;
+	entry.name = name;
+	entry.calls = 0;
+	entry.totalTime = 0;
+	entry.selfTime = 0;
+	_entries.push_back(entry);
+	index = _entries.size() - 1;
+	_entryMap[key] = index;
+
+	return true;
+}
+
+void LuaProfiler::handleHook(lua_State *L, lua_Debug *ar) {
+	if (!_enabled)
+		return;
+
+	uint now = g_system->getMillis();
+	CallStack &stack = getCallStack(L);
+
+	// Lua errors unwind the stack without return events, so the frames are
+	// matched by stack depth. Whatever is at or above the depth of the
+	// current event has been left already.
+	const int depth = getStackDepth(L);
+	closeFrames(stack, depth, now);
+
+	if (ar->event == LUA_HOOKCALL) {
+		// A call which cannot be identified is not accounted for. Its time
+		// counts towards the calling function.
+		Frame frame;
+		if (!getEntry(L, ar, frame.entry))
+			return;
+		frame.startTime = now;
+		frame.childTime = 0;
+		frame.depth = depth;
+		stack.frames.push_back(frame);
+		_entries[frame.entry].calls++;
+	} else if (stack.frames.empty()) {
+		// The coroutine may be gone, so do not keep its stack around
+		_callStacks.remove_at(_lastCallStack);
+		_lastCallStack = 0;
+	}
+}
+
+void LuaProfiler::dump(Common::WriteStream &out) const {
+	out.writeString("function,calls,total_ms,self_ms\n");
+	for (uint i = 0; i < _entries.size(); ++i) {
+		// Quote the name, since it may contain commas
+		Common::String name = _entries[i].name;
+		for (uint j = 0; j < name.size(); ++j) {
+			if (name[j] == '"')
+				name.setChar('\'', j);
+		}
+
+		out.writeString(Common::String::format("\"%s\",%d,%d,%d\n", name.c_str(),
+			_entries[i].calls, _entries[i].totalTime, _entries[i].selfTime));
+	}
+}
+
+} // End of namespace Sword25
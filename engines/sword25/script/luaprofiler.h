@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SWORD25_LUAPROFILER_H
+#define SWORD25_LUAPROFILER_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+#include "sword25/kernel/common.h"
+
+struct lua_State;
+struct lua_Debug;
+
+namespace Common {
+class WriteStream;
+}
+
+namespace Sword25 {
+
+/**
+ * Measures the time spent in each Lua function and C binding.
+ *
+ * The profiler is driven by the call and return hooks of the Lua VM. Times
+ * are taken with the millisecond clock, so short calls are only accounted
+ * for when they happen to span a clock tick; summed over many calls this
+ * gives a statistical estimate of where the time goes.
+ */
+class LuaProfiler {
+public:
+	struct Entry {
+		Common::String name;    ///< Function name and where it was defined
+		uint calls;             ///< Number of calls
+		uint totalTime;         ///< Milliseconds spent in the function, including called functions
+		uint selfTime;          ///< Milliseconds spent in the function itself
+	};
+
+	LuaProfiler();
+
+	/**
+	 * Enables or disables the profiler. The script engine installs the
+	 * hook which feeds it.
+	 */
+	void setEnabled(bool enabled);
+
+	bool isEnabled() const {
+		return _enabled;
+	}
+
+	/**
+	 * Discards all collected data.
+	 */
+	void reset();
+
+	/**
+	 * Writes the collected data as CSV.
+	 */
+	void dump(Common::WriteStream &out) const;
+
+	const Common::Array<Entry> &getEntries() const {
+		return _entries;
+	}
+
+	/**
+	 * Processes a hook event. Called from the hook function of the script engine.
+	 */
+	void handleHook(lua_State *L, lua_Debug *ar);
+
+	/**
+	 * Drops the call stacks of coroutines which have been garbage collected.
+	 * Called by the script engine after a garbage collection cycle.
+	 */
+	void removeDeadThreads(lua_State *L);
+
+private:
+	struct Frame {
+		uint entry;
+		uint startTime;
+		uint childTime;
+		int depth;              ///< Number of Lua stack levels when the function was called
+	};
+
+	struct CallStack {
+		lua_State *thread;
+		Common::Array<Frame> frames;
+	};
+
+	CallStack &getCallStack(lua_State *L);
+	void registerThread(lua_State *L);
+	void closeFrames(CallStack &stack, int depth, uint now);
+	bool getEntry(lua_State *L, lua_Debug *ar, uint &index);
+
+	bool _enabled;
+	Common::Array<Entry> _entries;
+	Common::HashMap<Common::String, uint> _entryMap;
+	Common::Array<CallStack> _callStacks;
+	uint _lastCallStack;
+};
+
+} // End of namespace Sword25
+
+#endif
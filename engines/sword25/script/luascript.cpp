@@ -31,11 +31,13 @@
 
 #include "common/array.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sword25/sword25.h"
 #include "sword25/package/packagemanager.h"
 #include "sword25/script/luascript.h"
 #include "sword25/script/luabindhelper.h"
+#include "sword25/kernel/kernel.h"
 
 #include "sword25/kernel/outputpersistenceblock.h"
 #include "sword25/kernel/inputpersistenceblock.h"
@@ -43,6 +45,7 @@
 #include "sword25/util/lua/lua.h"
 #include "sword25/util/lua/lualib.h"
 #include "sword25/util/lua/lauxlib.h"
+#include "sword25/util/lua/lstate.h"
 #include "sword25/util/pluto/pluto.h"
 
 namespace Sword25 {
@@ -50,7 +53,15 @@ namespace Sword25 {
 LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 	ScriptEngine(KernelPtr),
 	_state(0),
-	_pcallErrorhandlerRegistryIndex(0) {
+	_pcallErrorhandlerRegistryIndex(0),
+	_debugHookMask(0),
+	_gcPause(LUAI_GCPAUSE),
+	_gcStepMul(LUAI_GCMUL),
+	_gcStepSize(16),
+	_gcFrameBudget(2),
+	_gcWaitForKB(0),
+	_gcSteps(0),
+	_gcCycles(0) {
 }
 
 LuaScriptEngine::~LuaScriptEngine() {
@@ -71,6 +82,22 @@ void debugHook(lua_State *L, lua_Debug *ar) {
 
 	debug("LUA: %s %s: %s %d", ar->namewhat, ar->name, ar->short_src, ar->currentline);
 }
+
+void profilerHook(lua_State *L, lua_Debug *ar) {
+	static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript())->getProfiler().handleHook(L, ar);
+}
+
+/**
+ * Installs a hook in the main thread and in all existing coroutines.
+ * lua_sethook() only changes the given thread, and a new coroutine starts
+ * with the hook of the thread creating it.
+ */
+void setHookInAllThreads(lua_State *L, lua_Hook hook, int mask) {
+	for (GCObject *o = G(L)->rootgc; o; o = o->gch.next) {
+		if (o->gch.tt == LUA_TTHREAD)
+			lua_sethook(gco2th(o), hook, mask, 0);
+	}
+}
 }
 
 bool LuaScriptEngine::init() {
@@ -128,13 +155,67 @@ bool LuaScriptEngine::init() {
 
 		if (mask != 0)
 			lua_sethook(_state, debugHook, mask, 0);
+		_debugHookMask = mask;
 	}
 
+	applyGarbageCollectorSettings();
+
 	debugC(kDebugScript, "Lua initialized.");
 
 	return true;
 }
 
+void LuaScriptEngine::applyGarbageCollectorSettings() {
+	if (!_state)
+		return;
+
+	lua_gc(_state, LUA_GCSETPAUSE, _gcPause);
+	lua_gc(_state, LUA_GCSETSTEPMUL, _gcStepMul);
+	_gcWaitForKB = 0;
+}
+
+void LuaScriptEngine::collectGarbage(uint maxMillis) {
+	maxMillis = MIN(maxMillis, _gcFrameBudget);
+	if (!_state || !maxMillis || _gcStepSize <= 0)
+		return;
+
+	// After a complete cycle, wait until memory use has grown by half the
+	// pause before collecting again. This starts the next cycle well before
+	// the collector would start it on its own.
+	if (_gcWaitForKB && lua_gc(_state, LUA_GCCOUNT, 0) < _gcWaitForKB)
+		return;
+	_gcWaitForKB = 0;
+
+	uint startTime = g_system->getMillis();
+	do {
+		_gcSteps++;
+		if (lua_gc(_state, LUA_GCSTEP, _gcStepSize)) {
+			int kb = lua_gc(_state, LUA_GCCOUNT, 0);
+			_gcWaitForKB = MAX(1, kb + kb * (_gcPause - 100) / 200);
+			_gcCycles++;
+			if (_profiler.isEnabled())
+				_profiler.removeDeadThreads(_state);
+			break;
+		}
+	} while (g_system->getMillis() - startTime < maxMillis);
+}
+
+void LuaScriptEngine::setProfiling(bool enable) {
+	if (!_state || enable == _profiler.isEnabled())
+		return;
+
+	_profiler.setEnabled(enable);
+
+	// Only one hook can be installed, so the debug hook is put back when
+	// profiling stops
+	if (enable)
+		setHookInAllThreads(_state, profilerHook, LUA_MASKCALL | LUA_MASKRET);
+	else if (_debugHookMask)
+		setHookInAllThreads(_state, debugHook, _debugHookMask);
+	else
+		setHookInAllThreads(_state, 0, 0);
+}
+
 bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 #ifdef DEBUG
 	int __startStackDepth = lua_gettop(_state);
@@ -387,11 +468,8 @@ bool pushPermanentsTable(lua_State *L, PERMANENT_TABLE_TYPE tableType) {
 
 namespace {
 int chunkwriter(lua_State *L, const void *p, size_t sz, void *ud) {
-	Common::Array<byte> & chunkData = *reinterpret_cast<Common::Array<byte> * >(ud);
-	const byte *buffer = reinterpret_cast<const byte *>(p);
-
-	while (sz--)
-		chunkData.push_back(*buffer++);
+	OutputPersistenceBlock &writer = *reinterpret_cast<OutputPersistenceBlock *>(ud);
+	writer.writeByteArrayData(p, sz);
 
 	return 1;
 }
@@ -409,12 +487,10 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a Common::Array
-	Common::Array<byte> chunkData;
-	pluto_persist(_state, chunkwriter, &chunkData);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.writeByteArray(chunkData);
+	// Lua persists and streams the data straight into the writer
+	writer.beginByteArray();
+	pluto_persist(_state, chunkwriter, &writer);
+	writer.endByteArray();
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
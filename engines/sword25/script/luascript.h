@@ -36,14 +36,18 @@
 #include "common/str-array.h"
 #include "sword25/kernel/common.h"
 #include "sword25/script/script.h"
+#include "sword25/script/luaprofiler.h"
 
 struct lua_State;
 
 namespace Sword25 {
 
 class Kernel;
+class Sword25Console;
 
 class LuaScriptEngine : public ScriptEngine {
+	friend class Sword25Console;
+
 public:
 	LuaScriptEngine(Kernel *KernelPtr);
 	virtual ~LuaScriptEngine();
@@ -84,6 +88,22 @@ public:
 	 */
 	virtual void setCommandLine(const Common::StringArray &commandLineParameters);
 
+	/**
+	 * Runs incremental garbage collection steps until the given time has passed or a cycle
+	 * is complete. This spreads the work of the collector over the idle time of the frames,
+	 * instead of doing it while the scripts allocate.
+	 */
+	virtual void collectGarbage(uint maxMillis);
+
+	/**
+	 * Enables or disables the profiler, which measures the time spent in each Lua function
+	 */
+	void setProfiling(bool enable);
+
+	LuaProfiler &getProfiler() {
+		return _profiler;
+	}
+
 	/**
 	 * @remark              The Lua stack is cleared by this method
 	 */
@@ -96,6 +116,20 @@ public:
 private:
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
+	int _debugHookMask;
+
+	LuaProfiler _profiler;
+
+	// Garbage collector settings
+	int _gcPause;           ///< Growth of memory in percent after which a new cycle starts
+	int _gcStepMul;         ///< Speed of the collector relative to allocation in percent
+	int _gcStepSize;        ///< Size of the steps taken between frames in KB
+	uint _gcFrameBudget;    ///< Maximum time in milliseconds spent collecting between frames
+	int _gcWaitForKB;       ///< Memory use at which collecting between frames resumes after a cycle
+	uint _gcSteps;
+	uint _gcCycles;
+
+	void applyGarbageCollectorSettings();
 
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
@@ -84,6 +84,12 @@ public:
 	*/
 	virtual void setCommandLine(const Common::Array<Common::String> &commandLineParameters) = 0;
 
+	/**
+	 * Gives the script engine the chance to collect garbage between frames.
+	 * @param MaxMillis     The time in milliseconds left in the current frame
+	 */
+	virtual void collectGarbage(uint maxMillis) = 0;
+
 	virtual bool persist(OutputPersistenceBlock &writer) = 0;
 	virtual bool unpersist(InputPersistenceBlock &reader) = 0;
 };
@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Micro-benchmark comparing Common::HashMap and Common::FlatHashMap.
+// Use the 'benchmark' target to build and run it.
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_printf
+
+#include <stdio.h>
+#include <time.h>
+
+#include "common/array.h"
+#include "common/flat-hashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+namespace {
+
+enum {
+	kIntKeys = 200000,
+	kStringKeys = 50000,
+	kRounds = 5
+};
+
+double elapsed(clock_t start) {
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+// Keeps the compiler from dropping the loops below.
+uint g_sink = 0;
+
+/**
+ * Time inserting all keys, looking up every key (in random order) and the
+ * same number of missing keys, iterating over the map and erasing every
+ * second key.
+ */
+template<class Map, class Key>
+void runBenchmark(const char *name, const Common::Array<Key> &keys, const Common::Array<Key> &missingKeys) {
+	double insertTime = 0, lookupTime = 0, iterateTime = 0, eraseTime = 0;
+	const uint count = keys.size();
+
+	// Look keys up in a different order than they were inserted in, so
+	// that the benchmark does not depend on the allocation order of nodes.
+	Common::Array<uint> order;
+	for (uint i = 0; i < count; ++i)
+		order.push_back(i);
+	uint32 seed = 4711;
+	for (uint i = count - 1; i > 0; --i) {
+		seed = seed * 1103515245 + 12345;
+		SWAP(order[i], order[(seed >> 8) % (i + 1)]);
+	}
+
+	for (int round = 0; round < kRounds; ++round) {
+		Map map;
+		clock_t start = clock();
+		for (uint i = 0; i < count; ++i)
+			map[keys[i]] = i;
+		insertTime += elapsed(start);
+
+		start = clock();
+		for (uint i = 0; i < count; ++i) {
+			g_sink += map.getVal(keys[order[i]], 0);
+			g_sink += map.contains(missingKeys[i]) ? 1 : 0;
+		}
+		lookupTime += elapsed(start);
+
+		start = clock();
+		for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+			g_sink += it->_value;
+		iterateTime += elapsed(start);
+
+		start = clock();
+		for (uint i = 0; i < count; i += 2)
+			map.erase(keys[i]);
+		for (uint i = 0; i < count; ++i)
+			g_sink += map.contains(keys[order[i]]) ? 1 : 0;
+		eraseTime += elapsed(start);
+	}
+
+	printf("%-32s insert %8.2f  lookup %8.2f  iterate %8.2f  erase %8.2f (ms per round)\n", name,
+		insertTime / kRounds, lookupTime / kRounds, iterateTime / kRounds, eraseTime / kRounds);
+}
+
+} // End of anonymous namespace
+
+int main() {
+	// Random keys have the lowest bit cleared, missing keys have it set.
+	Common::Array<int> intKeys, missingIntKeys;
+	uint32 seed = 12345;
+	for (int i = 0; i < kIntKeys; ++i) {
+		seed = seed * 1103515245 + 12345;
+		intKeys.push_back((int)(seed >> 1) & ~1);
+		missingIntKeys.push_back((int)(seed >> 1) | 1);
+	}
+
+	Common::Array<int> sequentialKeys, missingSequentialKeys;
+	for (int i = 0; i < kIntKeys; ++i) {
+		sequentialKeys.push_back(i);
+		missingSequentialKeys.push_back(kIntKeys + i);
+	}
+
+	Common::Array<Common::String> stringKeys, missingStringKeys;
+	for (int i = 0; i < kStringKeys; ++i) {
+		stringKeys.push_back(Common::String::format("DATA/ROOM%03d/Resource_%05d.DAT", i % 100, i));
+		missingStringKeys.push_back(Common::String::format("DATA/ROOM%03d/Resource_%05d.BAK", i % 100, i));
+	}
+
+	runBenchmark<Common::HashMap<int, uint> >("HashMap<int> random", intKeys, missingIntKeys);
+	runBenchmark<Common::FlatHashMap<int, uint> >("FlatHashMap<int> random", intKeys, missingIntKeys);
+	runBenchmark<Common::HashMap<int, uint> >("HashMap<int> sequential", sequentialKeys, missingSequentialKeys);
+	runBenchmark<Common::FlatHashMap<int, uint> >("FlatHashMap<int> sequential", sequentialKeys, missingSequentialKeys);
+	runBenchmark<Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("HashMap<String> ignore case", stringKeys, missingStringKeys);
+	runBenchmark<Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("FlatHashMap<String> ignore case", stringKeys, missingStringKeys);
+
+	return g_sink == 0xFFFFFFFF ? 1 : 0;
+}
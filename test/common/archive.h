@@ -0,0 +1,133 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/hash-str.h"
+#include "common/memstream.h"
+
+class CountingArchive : public Common::Archive {
+public:
+	CountingArchive() : _hasFileCalls(0), _listCalls(0) {}
+
+	Common::StringMap _files;
+	mutable int _hasFileCalls;
+	mutable int _listCalls;
+
+	bool hasFile(const Common::String &name) const {
+		_hasFileCalls++;
+		return _files.contains(name);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const {
+		_listCalls++;
+		for (Common::StringMap::const_iterator i = _files.begin(); i != _files.end(); ++i)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(i->_key, this)));
+		return _files.size();
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+		if (!_files.contains(name))
+			return 0;
+		const Common::String &data = _files[name];
+		return new Common::MemoryReadStream((const byte *)data.c_str(), data.size());
+	}
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_priority_order() {
+		Common::SearchSet set;
+		CountingArchive *low = new CountingArchive();
+		CountingArchive *high = new CountingArchive();
+		low->_files["a.dat"] = "low";
+		low->_files["b.dat"] = "low";
+		high->_files["a.dat"] = "high";
+		set.add("low", low, 0);
+		set.add("high", high, 10);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 'h');
+		delete stream;
+
+		stream = set.createReadStreamForMember("b.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 'l');
+		delete stream;
+
+		TS_ASSERT(!set.createReadStreamForMember("c.dat"));
+	}
+
+	void test_archive_changes() {
+		Common::SearchSet set;
+		CountingArchive *low = new CountingArchive();
+		CountingArchive *high = new CountingArchive();
+		low->_files["a.dat"] = "low";
+		set.add("low", low, 0);
+		set.add("high", high, 10);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 'l');
+		delete stream;
+
+		// Files added to or removed from the archives are seen right away,
+		// also when a higher priority archive gains a file.
+		high->_files["a.dat"] = "high";
+		stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 'h');
+		delete stream;
+
+		high->_files.erase("a.dat");
+		low->_files.erase("a.dat");
+		TS_ASSERT(!set.hasFile("a.dat"));
+	}
+
+	void test_nested_sets() {
+		Common::SearchSet outer, inner;
+		outer.add("inner", &inner, 0, false);
+
+		TS_ASSERT(!outer.hasFile("a.dat"));
+
+		// Adding to the inner set must invalidate the cache of the outer one.
+		CountingArchive *arc = new CountingArchive();
+		arc->_files["a.dat"] = "a";
+		inner.add("arc", arc);
+		TS_ASSERT(outer.hasFile("a.dat"));
+
+		inner.remove("arc");
+		TS_ASSERT(!outer.hasFile("a.dat"));
+		outer.remove("inner");
+	}
+
+	void test_lookup_stats() {
+		Common::SearchSet set;
+		CountingArchive *first = new CountingArchive();
+		CountingArchive *second = new CountingArchive();
+		first->_files["a.dat"] = "a";
+		second->_files["b.dat"] = "b";
+		second->_files["c.txt"] = "c";
+		set.add("first", first, 10);
+		set.add("second", second, 0);
+
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(set.getMember("b.dat"));
+		TS_ASSERT(!set.hasFile("missing.dat"));
+
+		Common::ArchiveMemberList list;
+		TS_ASSERT_EQUALS(set.listMatchingMembers(list, "*.dat"), 2);
+
+		const Common::SearchSet::LookupStats &stats = set.getLookupStats();
+		TS_ASSERT_EQUALS(stats.lookups, 3U);
+		TS_ASSERT_EQUALS(stats.patternLookups, 1U);
+		TS_ASSERT_EQUALS(stats.archiveQueries, 7U);
+
+		set.resetLookupStats();
+		TS_ASSERT_EQUALS(set.getLookupStats().lookups, 0U);
+	}
+};
@@ -0,0 +1,50 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atom.h"
+#include "common/hash-str.h"
+
+class AtomTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_intern() {
+		Common::Atom a("AtomTest/File.DAT");
+		Common::Atom b(Common::String("atomtest/file.dat"));
+		Common::Atom c("AtomTest/Other.DAT");
+
+		TS_ASSERT(!a.isNull());
+		TS_ASSERT_EQUALS(a, b);
+		TS_ASSERT_DIFFERS(a, c);
+		TS_ASSERT_EQUALS(a.hash(), b.hash());
+		TS_ASSERT_EQUALS(a.hash(), Common::hashit_lower("ATOMTEST/FILE.DAT"));
+
+		// The first spelling is kept.
+		TS_ASSERT_EQUALS(b.toString(), "AtomTest/File.DAT");
+		TS_ASSERT_EQUALS(strcmp(b.c_str(), "AtomTest/File.DAT"), 0);
+	}
+
+	void test_find() {
+		TS_ASSERT(Common::Atom::find("AtomTest/never interned").isNull());
+
+		const uint count = Common::Atom::getInternedCount();
+		Common::Atom a("AtomTest/Find");
+		TS_ASSERT_EQUALS(Common::Atom::getInternedCount(), count + 1);
+		TS_ASSERT_EQUALS(Common::Atom::find("ATOMTEST/FIND"), a);
+		TS_ASSERT_EQUALS(Common::Atom::getInternedCount(), count + 1);
+	}
+
+	void test_null() {
+		Common::Atom null;
+		TS_ASSERT(null.isNull());
+		TS_ASSERT(null.toString().empty());
+		TS_ASSERT_DIFFERS(null, Common::Atom(""));
+	}
+
+	void test_hashmap_key() {
+		Common::HashMap<Common::Atom, int> map;
+		map[Common::Atom("AtomTest/a")] = 1;
+		map[Common::Atom("AtomTest/B")] = 2;
+		TS_ASSERT_EQUALS(map[Common::Atom("atomtest/A")], 1);
+		TS_ASSERT_EQUALS(map[Common::Atom("atomtest/b")], 2);
+		TS_ASSERT_EQUALS(map.size(), 2U);
+	}
+};
@@ -34,9 +34,18 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+# Micro-benchmarks, not run as part of the 'test' target.
+BENCHMARKS   := test/benchmark/hashmap
+
+benchmark: $(BENCHMARKS)
+	@for b in $(BENCHMARKS); do echo "$$b:"; ./$$b || exit 1; done
+test/benchmark/%: $(srcdir)/test/benchmark/%.cpp common/libcommon.a
+	@mkdir -p test/benchmark
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+
 
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner $(BENCHMARKS)
 
-.PHONY: test clean-test
+.PHONY: test benchmark clean-test